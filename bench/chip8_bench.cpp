@@ -0,0 +1,523 @@
+// Suíte de benchmarks de vazão do Chip-8
+// ROMs sintéticas que estressam caminhos específicos (ALU, CALL/RET, DXYN, FX33/FX55/FX65, CLS)
+// e ROMs reais (PONG, MAZE) em modo headless sem limite de velocidade, nos dois motores da CPU.
+// Mostra instruções/s, ns/instrução e quadros/s e grava tudo em JSON para acompanhar regressões.
+// Mede também a clonagem de MachineState usada em busca em árvore (clone pelo pool e fork:
+// restaurar um nó, avançar alguns quadros e guardar o filho) e o ambiente vetorizado (VecEnv).
+
+#include "../include/chip8.h"
+#include "../include/config.h"
+#include "../include/jit.h"
+#include "../include/lockstep.h"
+#include "../include/memory.h"
+#include "../include/null_platform.h"
+#include "../include/state_pool.h"
+#include "../include/vec_env.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Benchmark {
+    std::string name;
+    std::string kind;            // "micro" (sintética) ou "macro" (ROM real)
+    std::vector<uint8_t> rom;
+    int ipf;                     // Instruções por quadro
+    uint64_t frames;             // Quadros por repetição
+};
+
+struct Result {
+    uint64_t instructions = 0;
+    uint64_t frames = 0;
+    double seconds = 0;
+    uint64_t hash = 0;
+};
+
+// Monta uma ROM a partir de opcodes, com dados opcionais a partir de data_at
+std::vector<uint8_t> assemble(const std::vector<uint16_t>& code, uint16_t data_at = 0, const std::vector<uint8_t>& data = {}) {
+    std::vector<uint8_t> rom;
+    for (uint16_t opcode : code) {
+        rom.push_back(opcode >> 8);
+        rom.push_back(opcode & 0xFF);
+    }
+    if (!data.empty()) {
+        size_t offset = data_at - Config::Memory::PROGRAM_START;
+        if (rom.size() < offset) rom.resize(offset, 0);
+        rom.insert(rom.end(), data.begin(), data.end());
+    }
+    return rom;
+}
+
+// ROMs sintéticas: cada uma é um laço fechado sobre o caminho medido
+std::vector<Benchmark> synthetic(uint64_t frames) {
+    std::vector<Benchmark> list;
+
+    // ALU: todas as operações 8XY* e 7XKK
+    list.push_back({"alu", "micro", assemble({
+        0x6001, 0x6103, 0x6207,                     // 200: V0 = 1, V1 = 3, V2 = 7
+        0x8014, 0x8125, 0x8201, 0x8312, 0x8403,     // 206: ADD, SUB, OR, AND, XOR
+        0x8506, 0x860E, 0x8717, 0x8010, 0x7001,     // 210: SHR, SHL, SUBN, LD, ADD byte
+        0x1206,                                     // 21A: JP 206
+    }), 1000, frames});
+
+    // CALL/RET: cadeia de três níveis
+    list.push_back({"call", "micro", assemble({
+        0x2210, 0x1200, 0x0000, 0x0000,             // 200: CALL 210, JP 200
+        0x0000, 0x0000, 0x0000, 0x0000,
+        0x2220, 0x00EE, 0x0000, 0x0000,             // 210: CALL 220, RET
+        0x0000, 0x0000, 0x0000, 0x0000,
+        0x2230, 0x00EE, 0x0000, 0x0000,             // 220: CALL 230, RET
+        0x0000, 0x0000, 0x0000, 0x0000,
+        0x7001, 0x00EE,                             // 230: V0++, RET
+    }), 1000, frames});
+
+    // DXYN: sprites de 15 linhas em posições que andam pela tela (com recorte e colisão)
+    list.push_back({"drw", "micro", assemble({
+        0xA300, 0x6000, 0x6100,                     // 200: I = 300, V0 = 0, V1 = 0
+        0xD01F, 0x7003, 0x7105, 0x1206,             // 206: DRW V0, V1, 15; V0 += 3; V1 += 5; JP 206
+    }, 0x300, {0xFF, 0x81, 0xBD, 0xA5, 0xA5, 0xBD, 0x81, 0xFF, 0x3C, 0x42, 0x99, 0x99, 0x42, 0x3C, 0x18}),
+        1000, frames});
+
+    // Memória: BCD e cópias de 16 registradores para a RAM e de volta
+    list.push_back({"mem", "micro", assemble({
+        0xA400, 0x6000,                             // 200: I = 400, V0 = 0
+        0xF033, 0xFF55, 0xFF65, 0x7001, 0x1204,     // 204: LD B, LD [I], LD Vx, [I]; V0++; JP 204
+    }), 1000, frames});
+
+    // CLS em sequência, com um sprite entre as limpezas
+    list.push_back({"cls", "micro", assemble({
+        0x6000, 0x6100,                             // 200: V0 = 0, V1 = 0
+        0x00E0, 0x00E0, 0xF029, 0xD015, 0x00E0,     // 204: CLS, CLS, LD F, DRW, CLS
+        0x00E0, 0x1204,                             // 20E: CLS, JP 204
+    }), 1000, frames});
+
+    return list;
+}
+
+// Executa uma repetição em uma instância nova
+Result run_once(const Benchmark& bench, CpuBackend backend, bool fusion = true) {
+    NullPlatform platform;
+    Chip8 chip8(false);
+    chip8.initialize(platform);
+    chip8.load_rom(bench.rom);
+    chip8.set_seed(1);
+    chip8.set_cpu_backend(backend);
+    chip8.set_fusion(fusion);
+    chip8.set_instructions_per_frame(bench.ipf);
+
+    Result result;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t f = 0; f < bench.frames; ++f) result.instructions += chip8.run_frame();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.frames = bench.frames;
+    result.hash = chip8.get_display().hash();
+    return result;
+}
+
+struct CloneResult {
+    uint64_t ops = 0;
+    uint64_t frames = 0;
+    double seconds = 0;
+    bool deterministic = true;
+    int interpreted_blocks = 0;            // vecenv: blocos do JIT rebaixados nos executores
+    int reference_interpreted_blocks = 0;  // vecenv: o mesmo nos Chip8 avulsos (sem restaurar estados)
+};
+
+constexpr int FORK_FRAMES = 4; // Quadros avançados por nó no fork
+
+// Compara o estado emulado de duas máquinas (campo a campo: o preenchimento não conta)
+bool same_machine(const MachineState& a, const MachineState& b) {
+    return std::memcmp(&a.cpu, &b.cpu, sizeof(a.cpu)) == 0 && a.input.keys == b.input.keys &&
+           a.input.presses == b.input.presses && a.display.rows == b.display.rows && a.ram == b.ram;
+}
+
+// Máquina pronta para a busca: ROM carregada e alguns quadros já executados
+void prepare(Chip8& chip8, NullPlatform& platform, const Benchmark& bench, CpuBackend backend) {
+    chip8.initialize(platform);
+    chip8.load_rom(bench.rom);
+    chip8.set_seed(1);
+    chip8.set_cpu_backend(backend);
+    chip8.set_instructions_per_frame(bench.ipf);
+    for (int f = 0; f < 60; ++f) chip8.run_frame();
+}
+
+// Clone pelo pool: cópia da raiz em um estado reciclado
+CloneResult run_clone(const Benchmark& bench, uint64_t count) {
+    NullPlatform platform;
+    Chip8 chip8(false);
+    prepare(chip8, platform, bench, CpuBackend::Interpreter);
+    StatePool pool(64);
+    const MachineState& root = chip8.get_state();
+
+    CloneResult result;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < count; ++i) pool.release(pool.clone(root));
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.ops = count;
+
+    MachineState* node = pool.clone(root);
+    result.deterministic = same_machine(*node, root) && pool.capacity() == 64;
+    return result;
+}
+
+// Fork: restaura a raiz, avança FORK_FRAMES quadros com uma tecla por nó e guarda o filho;
+// confere que o mesmo fork feito de novo (depois de outros) dá o mesmo estado
+CloneResult run_fork(const Benchmark& bench, CpuBackend backend, uint64_t count) {
+    NullPlatform platform;
+    Chip8 chip8(false);
+    prepare(chip8, platform, bench, backend);
+    StatePool pool(64);
+    MachineState* root = pool.acquire();
+    chip8.save_state(*root);
+
+    auto fork = [&](uint64_t i, MachineState& child) {
+        chip8.load_state(*root);
+        uint8_t key = static_cast<uint8_t>(i % 17);
+        for (int f = 0; f < FORK_FRAMES; ++f) {
+            if (key < 16) chip8.set_key(key, f < FORK_FRAMES / 2);
+            chip8.run_frame();
+        }
+        chip8.save_state(child);
+    };
+
+    CloneResult result;
+    MachineState* first = pool.acquire();
+    fork(1, *first);
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < count; ++i) {
+        MachineState* child = pool.acquire();
+        fork(i, *child);
+        pool.release(child);
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.ops = count;
+    result.frames = count * FORK_FRAMES;
+
+    MachineState* again = pool.acquire();
+    fork(1, *again);
+    result.deterministic = same_machine(*first, *again);
+    return result;
+}
+
+constexpr int VEC_ENVS = 64;                // Instâncias no benchmark do ambiente vetorizado
+constexpr uint64_t LOCKSTEP_CHECK_FRAMES = 600; // Quadros do teste diferencial das lanes
+
+// Teclas da instância i no passo step: trocam a cada 8 passos, às vezes nenhuma
+uint16_t vec_env_keys(int i, uint64_t step) {
+    uint64_t key = (step / 8 + i) % 17;
+    return key < 16 ? static_cast<uint16_t>(1u << key) : 0;
+}
+
+// Ambiente vetorizado: VEC_ENVS instâncias avançando FORK_FRAMES quadros por passo; confere a
+// primeira e a última contra um Chip8 avulso com a mesma semente e as mesmas teclas, e que as
+// restaurações a cada passo não rebaixaram blocos do JIT além dos do Chip8 avulso
+CloneResult run_vec_env(const Benchmark& bench, CpuBackend backend, uint64_t steps) {
+    VecEnvOptions options;
+    options.ipf = bench.ipf;
+    options.backend = backend;
+    VecEnv env(bench.rom, VEC_ENVS, options);
+    std::vector<uint16_t> keys(VEC_ENVS);
+
+    CloneResult result;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t step = 0; step < steps; ++step) {
+        for (int i = 0; i < VEC_ENVS; ++i) keys[i] = vec_env_keys(i, step);
+        env.step(keys.data(), FORK_FRAMES);
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.ops = steps * VEC_ENVS;
+    result.frames = result.ops * FORK_FRAMES;
+
+    for (int i : {0, VEC_ENVS - 1}) {
+        NullPlatform platform;
+        Chip8 chip8(false);
+        chip8.initialize(platform);
+        chip8.load_rom(bench.rom);
+        chip8.set_seed(options.seed + i);
+        chip8.set_cpu_backend(backend);
+        chip8.set_instructions_per_frame(bench.ipf);
+        for (uint64_t step = 0; step < steps; ++step) {
+            chip8.apply_keys(vec_env_keys(i, step), 0);
+            for (int f = 0; f < FORK_FRAMES; ++f) chip8.run_frame();
+        }
+        const uint8_t* frame = env.framebuffers() + i * VecEnv::FRAME_BYTES;
+        bool same_frame = true;
+        for (int y = 0; y < Display::HEIGHT; ++y) {
+            for (int x = 0; x < Display::WIDTH; ++x) {
+                same_frame &= chip8.get_display().get_pixel(x, y) == (((frame[y * 8 + x / 8] >> (7 - x % 8)) & 1) != 0);
+            }
+        }
+        result.deterministic &= same_frame && same_machine(chip8.get_state(), env.state(i));
+        result.reference_interpreted_blocks = std::max(result.reference_interpreted_blocks, chip8.get_jit_interpreted_blocks());
+    }
+    result.interpreted_blocks = env.get_jit_interpreted_blocks();
+    return result;
+}
+
+// Lanes com as sementes 1, 2, ... (a lane 0 é a instância de run_once)
+void boot_lanes(LockstepGroup& group, const Benchmark& bench) {
+    NullPlatform platform;
+    Chip8 chip8(false);
+    chip8.initialize(platform);
+    chip8.load_rom(bench.rom);
+    MachineState state;
+    for (int l = 0; l < group.size(); ++l) {
+        chip8.set_seed(1 + l);
+        chip8.save_state(state);
+        group.load_lane(l, state);
+    }
+}
+
+// Interpretador em lockstep: LANES sementes da mesma ROM; instruções somadas nas lanes
+Result run_lockstep(const Benchmark& bench) {
+    LockstepGroup group(LockstepGroup::LANES, bench.ipf);
+    boot_lanes(group, bench);
+
+    Result result;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t f = 0; f < bench.frames; ++f) result.instructions += group.run_frame() * static_cast<uint64_t>(group.size());
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.frames = bench.frames * group.size();
+    result.hash = group.get_display(0).hash();
+    return result;
+}
+
+// Teste diferencial: cada lane, com semente e teclas próprias, contra um Chip8 escalar
+bool lockstep_matches_scalar(const Benchmark& bench, uint64_t frames) {
+    LockstepGroup group(LockstepGroup::LANES, bench.ipf);
+    boot_lanes(group, bench);
+    std::vector<std::unique_ptr<Chip8>> scalar;
+    NullPlatform platform;
+    for (int l = 0; l < group.size(); ++l) {
+        scalar.emplace_back(new Chip8(false));
+        scalar[l]->initialize(platform);
+        scalar[l]->load_rom(bench.rom);
+        scalar[l]->set_seed(1 + l);
+        scalar[l]->set_instructions_per_frame(bench.ipf);
+    }
+    for (uint64_t f = 0; f < frames; ++f) {
+        for (int l = 0; l < group.size(); ++l) {
+            group.apply_keys(l, vec_env_keys(l, f / 4), 0);
+            scalar[l]->apply_keys(vec_env_keys(l, f / 4), 0);
+            scalar[l]->run_frame();
+        }
+        group.run_frame();
+    }
+    MachineState state;
+    for (int l = 0; l < group.size(); ++l) {
+        group.save_lane(l, state);
+        if (!same_machine(state, scalar[l]->get_state()) || group.get_idle_cycles(l) != scalar[l]->get_idle_cycles()) {
+            std::cerr << "[bench] ERRO: " << bench.name << ": lane " << l << " diverge do interpretador escalar" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+void print_usage(const char* exe) {
+    std::cout << "Uso: " << exe << " [--json <arquivo>] [--label <texto>] [--frames <n>] [--reps <n>] [--rom <arquivo> ...] [--only <nome>]" << std::endl;
+    std::cout << "  --json <arquivo>  Grava os resultados em JSON" << std::endl;
+    std::cout << "  --label <texto>   Rótulo da execução no JSON (ex.: hash do commit)" << std::endl;
+    std::cout << "  --frames <n>      Quadros por repetição nas ROMs sintéticas (padrão: 10000, 1000 instr/quadro)" << std::endl;
+    std::cout << "  --reps <n>        Repetições por benchmark; vale a mais rápida (padrão: 3)" << std::endl;
+    std::cout << "  --rom <arquivo>   ROM real para benchmark macro (padrão: roms/PONG e roms/MAZE)" << std::endl;
+    std::cout << "  --only <nome>     Roda só os benchmarks com este nome" << std::endl;
+}
+
+// Escapa uma string para JSON
+std::string json_string(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20) out += c;
+    }
+    return out + "\"";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string json_path;
+    std::string label;
+    std::string only;
+    uint64_t frames = 10000;
+    int reps = 3;
+    std::vector<std::string> roms;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&](const char* name) -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "[bench] ERRO: Falta valor para " << name << std::endl;
+                print_usage(argv[0]);
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+        try {
+            if (arg == "--json") {
+                json_path = value("--json");
+            } else if (arg == "--label") {
+                label = value("--label");
+            } else if (arg == "--only") {
+                only = value("--only");
+            } else if (arg == "--frames") {
+                long long v = std::stoll(value("--frames"));
+                if (v <= 0) throw std::invalid_argument("frames");
+                frames = static_cast<uint64_t>(v);
+            } else if (arg == "--reps") {
+                reps = std::stoi(value("--reps"));
+                if (reps <= 0) throw std::invalid_argument("reps");
+            } else if (arg == "--rom") {
+                roms.push_back(value("--rom"));
+            } else if (arg == "--help" || arg == "-h") {
+                print_usage(argv[0]);
+                return 0;
+            } else {
+                std::cerr << "[bench] ERRO: Argumento desconhecido: " << arg << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "[bench] ERRO: Valor inválido para " << arg << std::endl;
+            return 1;
+        }
+    }
+    if (roms.empty()) roms = {"roms/PONG", "roms/MAZE"};
+
+    std::vector<Benchmark> benchmarks = synthetic(frames);
+
+    // Macro: ROMs reais no clock padrão (o que a execução headless de fato faz, com laços ociosos)
+    for (const std::string& path : roms) {
+        Benchmark bench;
+        if (!Memory::read_rom_file(path, bench.rom)) {
+            std::cerr << "[bench] AVISO: ROM ignorada: " << path << std::endl;
+            continue;
+        }
+        bench.name = path.substr(path.find_last_of("/\\") + 1);
+        bench.kind = "macro";
+        bench.ipf = (Config::CPU::DEFAULT_CLOCK_SPEED + Config::CPU::TIMER_FREQUENCY / 2) / Config::CPU::TIMER_FREQUENCY;
+        bench.frames = frames * 20;
+        benchmarks.push_back(bench);
+    }
+
+    struct Backend { const char* name; CpuBackend backend; bool fusion; };
+    std::vector<Backend> backends = {{"interp", CpuBackend::Interpreter, true}, {"nofuse", CpuBackend::Interpreter, false}};
+    if (Jit::is_supported()) backends.push_back({"jit", CpuBackend::Jit, true});
+
+    std::string json = "{\n  \"label\": " + json_string(label) + ",\n  \"benchmarks\": [";
+    bool first = true;
+    bool ok = true;
+
+    std::printf("%-10s %-6s %-7s %14s %10s %14s\n", "benchmark", "tipo", "motor", "instr/s", "ns/instr", "quadros/s");
+    for (const Benchmark& bench : benchmarks) {
+        if (!only.empty() && bench.name != only) continue;
+        uint64_t reference_hash = 0;
+        // Motores escalares e, por último, o interpretador em lockstep ("lanes")
+        for (size_t e = 0; e <= backends.size(); ++e) {
+            bool lanes = e == backends.size();
+            const char* engine = lanes ? "lanes" : backends[e].name;
+            Result best;
+            for (int rep = 0; rep < reps; ++rep) {
+                Result r = lanes ? run_lockstep(bench) : run_once(bench, backends[e].backend, backends[e].fusion);
+                if (rep == 0 || r.seconds < best.seconds) best = r;
+            }
+            if (e == 0) {
+                reference_hash = best.hash;
+            } else if (best.hash != reference_hash) {
+                std::cerr << "[bench] ERRO: " << bench.name << ": framebuffer do motor " << engine
+                          << " diverge do interpretador" << std::endl;
+                ok = false;
+            }
+            if (lanes && !lockstep_matches_scalar(bench, std::min<uint64_t>(bench.frames, LOCKSTEP_CHECK_FRAMES))) ok = false;
+
+            double ips = best.seconds > 0 ? best.instructions / best.seconds : 0;
+            double ns = best.instructions ? best.seconds * 1e9 / best.instructions : 0;
+            double fps = best.seconds > 0 ? best.frames / best.seconds : 0;
+            std::printf("%-10s %-6s %-7s %14.0f %10.3f %14.0f\n", bench.name.c_str(), bench.kind.c_str(), engine, ips, ns, fps);
+
+            char entry[512];
+            std::snprintf(entry, sizeof(entry),
+                          "%s\n    {\"name\": %s, \"kind\": \"%s\", \"backend\": \"%s\", \"ipf\": %d, \"frames\": %llu, "
+                          "\"instructions\": %llu, \"seconds\": %.6f, \"instr_per_sec\": %.0f, \"ns_per_instr\": %.4f, "
+                          "\"frames_per_sec\": %.0f, \"hash\": \"0x%016llx\"}",
+                          first ? "" : ",", json_string(bench.name).c_str(), bench.kind.c_str(), engine, bench.ipf,
+                          static_cast<unsigned long long>(best.frames), static_cast<unsigned long long>(best.instructions),
+                          best.seconds, ips, ns, fps, static_cast<unsigned long long>(best.hash));
+            json += entry;
+            first = false;
+        }
+    }
+    // Busca em árvore: a ROM macro (ou a sintética de sprites) como ambiente
+    const Benchmark* tree = nullptr;
+    for (const Benchmark& bench : benchmarks) {
+        if (bench.kind == "macro" || (!tree && bench.name == "drw")) tree = &bench;
+        if (bench.kind == "macro") break;
+    }
+    if (tree && (only.empty() || only == "clone" || only == "fork" || only == "vecenv")) {
+        std::printf("\n%-10s %-6s %-7s %14s %10s %14s  (%s)\n", "caso", "tipo", "motor", "ops/s", "ns/op", "quadros/s",
+                    tree->name.c_str());
+        struct Case { const char* name; const char* backend; CpuBackend cpu; uint64_t count; };
+        std::vector<Case> cases = {{"clone", "-", CpuBackend::Interpreter, frames * 100}};
+        for (const Backend& backend : backends) {
+            if (backend.fusion) cases.push_back({"fork", backend.name, backend.backend, frames * 10});
+        }
+        for (const Backend& backend : backends) {
+            if (backend.fusion) cases.push_back({"vecenv", backend.name, backend.backend, frames / 4});
+        }
+        for (const Case& c : cases) {
+            if (!only.empty() && only != c.name) continue;
+            CloneResult best;
+            for (int rep = 0; rep < reps; ++rep) {
+                CloneResult r = std::strcmp(c.name, "clone") == 0 ? run_clone(*tree, c.count)
+                              : std::strcmp(c.name, "fork") == 0 ? run_fork(*tree, c.cpu, c.count)
+                                                                 : run_vec_env(*tree, c.cpu, c.count);
+                if (!r.deterministic) {
+                    std::cerr << "[bench] ERRO: " << c.name << " (" << c.backend << "): " << (std::strcmp(c.name, "vecenv") == 0 ? "ambiente diverge do Chip8 avulso" : "clone diverge do estado de origem") << std::endl;
+                    ok = false;
+                }
+                if (r.interpreted_blocks > r.reference_interpreted_blocks) {
+                    std::cerr << "[bench] ERRO: " << c.name << " (" << c.backend << "): " << r.interpreted_blocks
+                              << " blocos do JIT no interpretador depois das restaurações (" << r.reference_interpreted_blocks
+                              << " sem restaurar)" << std::endl;
+                    ok = false;
+                }
+                if (rep == 0 || r.seconds < best.seconds) best = r;
+            }
+            double ops = best.seconds > 0 ? best.ops / best.seconds : 0;
+            double ns = best.ops ? best.seconds * 1e9 / best.ops : 0;
+            double fps = best.seconds > 0 ? best.frames / best.seconds : 0;
+            std::printf("%-10s %-6s %-7s %14.0f %10.3f %14.0f\n", c.name, "tree", c.backend, ops, ns, fps);
+
+            char entry[512];
+            std::snprintf(entry, sizeof(entry),
+                          "%s\n    {\"name\": \"%s\", \"kind\": \"tree\", \"backend\": \"%s\", \"rom\": %s, \"ops\": %llu, "
+                          "\"frames\": %llu, \"seconds\": %.6f, \"ops_per_sec\": %.0f, \"ns_per_op\": %.4f, \"frames_per_sec\": %.0f}",
+                          first ? "" : ",", c.name, c.backend, json_string(tree->name).c_str(),
+                          static_cast<unsigned long long>(best.ops), static_cast<unsigned long long>(best.frames),
+                          best.seconds, ops, ns, fps);
+            json += entry;
+            first = false;
+        }
+    }
+    json += "\n  ]\n}\n";
+
+    if (!json_path.empty()) {
+        std::ofstream out(json_path);
+        if (!out.is_open() || !(out << json)) {
+            std::cerr << "[bench] ERRO: Não foi possível gravar " << json_path << std::endl;
+            return 1;
+        }
+        std::cout << "[bench] Resultados gravados em " << json_path << std::endl;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,232 @@
+// Microbenchmark de despacho de opcodes
+// Compara a antiga árvore de switches (decodifica a cada instrução) com a tabela
+// gerada em tempo de compilação, com e sem computed goto, sobre um programa cheio de desvios
+
+#include "../include/opcodes.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// Máquina mínima: só registradores, I e PC (o bastante para ALU, saltos e desvios)
+struct MiniCpu {
+    std::array<uint8_t, 4096> ram{};
+    std::array<uint8_t, 16> V{};
+    uint16_t I = 0;
+    uint16_t PC = 0x200;
+};
+
+struct Decoded {
+    Op op;
+    uint8_t x, y, kk;
+    uint16_t nnn;
+};
+
+// Semântica compartilhada pelos três despachantes
+inline void alu(MiniCpu& c, uint8_t n, uint8_t x, uint8_t y) {
+    switch (n) {
+        case 0x0: c.V[x] = c.V[y]; break;
+        case 0x1: c.V[x] |= c.V[y]; break;
+        case 0x2: c.V[x] &= c.V[y]; break;
+        case 0x3: c.V[x] ^= c.V[y]; break;
+        case 0x4: { uint16_t sum = c.V[x] + c.V[y]; c.V[0xF] = sum > 0xFF; c.V[x] = sum & 0xFF; break; }
+        case 0x5: c.V[0xF] = c.V[x] > c.V[y]; c.V[x] -= c.V[y]; break;
+        case 0x6: c.V[0xF] = c.V[x] & 1; c.V[x] >>= 1; break;
+        case 0x7: c.V[0xF] = c.V[y] > c.V[x]; c.V[x] = c.V[y] - c.V[x]; break;
+        case 0xE: c.V[0xF] = c.V[x] >> 7; c.V[x] <<= 1; break;
+    }
+}
+
+// Programa sintético com muitos desvios: contadores aninhados, skips e saltos curtos
+void build_program(MiniCpu& c) {
+    const uint16_t program[] = {
+        0x6000, 0x6100, 0x6207, 0x6301,     // 200: V0 = 0, V1 = 0, V2 = 7, V3 = 1
+        0x7001, 0x8104, 0x4000, 0x7101,     // 208: V0++, V1 += V0, SNE V0, 0 / V1++
+        0x8216, 0x3200, 0x1216, 0x6207,     // 210: V2 >>= 1, SE V2, 0 / JP 216 / V2 = 7
+        0x8312, 0x5010, 0x9010, 0x7302,     // 218: V3 &= V1, SE V0, V1, SNE V0, V1 / V3 += 2
+        0x8035, 0x8107, 0x810E, 0x4F01,     // 220: V0 -= V3, V1 = V0 - V1, V1 <<= 1, SNE VF, 1
+        0xA300, 0x8013, 0x3080, 0x1204,     // 228: I = 300, V0 ^= V1, SE V0, 0x80 / JP 204 (laço)
+        0x6000, 0x1204,                     // 230: V0 = 0, JP 204
+    };
+    for (size_t i = 0; i < sizeof(program) / sizeof(program[0]); ++i) {
+        c.ram[0x200 + 2 * i] = program[i] >> 8;
+        c.ram[0x200 + 2 * i + 1] = program[i] & 0xFF;
+    }
+}
+
+// 1) Árvore de switches aninhados, decodificando a cada instrução (implementação antiga)
+void run_switch_tree(MiniCpu& c, long cycles) {
+    for (long i = 0; i < cycles; ++i) {
+        uint16_t opcode = (c.ram[c.PC] << 8) | c.ram[c.PC + 1];
+        c.PC += 2;
+        uint8_t x = (opcode & 0x0F00) >> 8;
+        uint8_t y = (opcode & 0x00F0) >> 4;
+        uint8_t kk = opcode & 0x00FF;
+        uint16_t nnn = opcode & 0x0FFF;
+        switch (opcode & 0xF000) {
+            case 0x1000: c.PC = nnn; break;
+            case 0x3000: if (c.V[x] == kk) c.PC += 2; break;
+            case 0x4000: if (c.V[x] != kk) c.PC += 2; break;
+            case 0x5000: if (c.V[x] == c.V[y]) c.PC += 2; break;
+            case 0x6000: c.V[x] = kk; break;
+            case 0x7000: c.V[x] += kk; break;
+            case 0x8000:
+                switch (opcode & 0x000F) {
+                    case 0x0: case 0x1: case 0x2: case 0x3: case 0x4:
+                    case 0x5: case 0x6: case 0x7: case 0xE: alu(c, opcode & 0xF, x, y); break;
+                    default: break;
+                }
+                break;
+            case 0x9000: if (c.V[x] != c.V[y]) c.PC += 2; break;
+            case 0xA000: c.I = nnn; break;
+            default: break;
+        }
+    }
+}
+
+// Executa a operação K (o switch em K é resolvido em tempo de compilação)
+template <Op K>
+inline void execute(MiniCpu& c, const Decoded& d) {
+    switch (K) {
+        case Op::JP: c.PC = d.nnn; break;
+        case Op::SE_BYTE: if (c.V[d.x] == d.kk) c.PC += 2; break;
+        case Op::SNE_BYTE: if (c.V[d.x] != d.kk) c.PC += 2; break;
+        case Op::SE_REG: if (c.V[d.x] == c.V[d.y]) c.PC += 2; break;
+        case Op::SNE_REG: if (c.V[d.x] != c.V[d.y]) c.PC += 2; break;
+        case Op::LD_BYTE: c.V[d.x] = d.kk; break;
+        case Op::ADD_BYTE: c.V[d.x] += d.kk; break;
+        case Op::LD_REG: alu(c, 0x0, d.x, d.y); break;
+        case Op::OR: alu(c, 0x1, d.x, d.y); break;
+        case Op::AND: alu(c, 0x2, d.x, d.y); break;
+        case Op::XOR: alu(c, 0x3, d.x, d.y); break;
+        case Op::ADD_REG: alu(c, 0x4, d.x, d.y); break;
+        case Op::SUB: alu(c, 0x5, d.x, d.y); break;
+        case Op::SHR: alu(c, 0x6, d.x, d.y); break;
+        case Op::SUBN: alu(c, 0x7, d.x, d.y); break;
+        case Op::SHL: alu(c, 0xE, d.x, d.y); break;
+        case Op::LD_I: c.I = d.nnn; break;
+        default: break;
+    }
+}
+
+Decoded decode(uint16_t opcode) {
+    return Decoded{OPCODE_TABLE[opcode], uint8_t((opcode >> 8) & 0xF), uint8_t((opcode >> 4) & 0xF),
+                   uint8_t(opcode & 0xFF), uint16_t(opcode & 0xFFF)};
+}
+
+using ExecFn = void (*)(MiniCpu&, const Decoded&);
+
+constexpr ExecFn EXEC_TABLE[OP_COUNT] = {
+#define BENCH_EXEC(name, mnemonic) &execute<Op::name>,
+    CHIP8_OPCODES(BENCH_EXEC)
+#undef BENCH_EXEC
+};
+
+// 2) Tabela constexpr de opcodes + tabela de handlers, ainda decodificando a cada instrução
+void run_table(MiniCpu& c, long cycles) {
+    for (long i = 0; i < cycles; ++i) {
+        uint16_t opcode = (c.ram[c.PC] << 8) | c.ram[c.PC + 1];
+        c.PC += 2;
+        Decoded d = decode(opcode);
+        EXEC_TABLE[static_cast<size_t>(d.op)](c, d);
+    }
+}
+
+#if CHIP8_THREADED_DISPATCH
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+// 3) Cache pré-decodificado + computed goto (mesma estrutura de CPU::run_interpreter)
+void run_threaded(MiniCpu& c, long cycles) {
+    static std::array<Decoded, 4096> cache;
+    for (uint16_t pc = 0; pc < 4095; ++pc) cache[pc] = decode((c.ram[pc] << 8) | c.ram[pc + 1]);
+    long executed = 0;
+    const Decoded* d;
+#if CHIP8_THREADED_DISPATCH
+    static void* const labels[OP_COUNT] = {
+#define BENCH_LABEL(name, mnemonic) &&op_##name,
+        CHIP8_OPCODES(BENCH_LABEL)
+#undef BENCH_LABEL
+    };
+#define BENCH_DISPATCH()                             \
+    do {                                             \
+        if (executed++ >= cycles) return;            \
+        d = &cache[c.PC];                            \
+        c.PC += 2;                                   \
+        goto *labels[static_cast<size_t>(d->op)];    \
+    } while (0)
+
+    BENCH_DISPATCH();
+#define BENCH_CASE(name, mnemonic) \
+    op_##name:                     \
+        execute<Op::name>(c, *d);  \
+        BENCH_DISPATCH();
+    CHIP8_OPCODES(BENCH_CASE)
+#undef BENCH_CASE
+#undef BENCH_DISPATCH
+#else
+    while (executed++ < cycles) {
+        d = &cache[c.PC];
+        c.PC += 2;
+        EXEC_TABLE[static_cast<size_t>(d->op)](c, *d);
+    }
+#endif
+}
+#if CHIP8_THREADED_DISPATCH
+#pragma GCC diagnostic pop
+#endif
+
+using RunFn = void (*)(MiniCpu&, long);
+
+// Mede o melhor de algumas repetições e devolve ns/instrução
+double measure(RunFn fn, long cycles, MiniCpu& final_state) {
+    double best = 1e30;
+    for (int rep = 0; rep < 5; ++rep) {
+        MiniCpu c;
+        build_program(c);
+        auto start = std::chrono::steady_clock::now();
+        fn(c, cycles);
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / cycles;
+        if (ns < best) best = ns;
+        final_state = c;
+    }
+    return best;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    long cycles = argc > 1 ? std::atol(argv[1]) : 50'000'000;
+    if (cycles <= 0) cycles = 50'000'000;
+
+    struct Variant { const char* name; RunFn fn; };
+    const Variant variants[] = {
+        {"switch-tree", run_switch_tree},
+        {"constexpr-table", run_table},
+        {CHIP8_THREADED_DISPATCH ? "threaded-goto" : "predecoded-switch", run_threaded},
+    };
+
+    std::printf("Despacho de opcodes (%ld instruções por execução)\n", cycles);
+    MiniCpu reference;
+    double baseline = 0;
+    bool ok = true;
+    for (const Variant& v : variants) {
+        MiniCpu state;
+        double ns = measure(v.fn, cycles, state);
+        if (&v == &variants[0]) {
+            reference = state;
+            baseline = ns;
+        } else if (state.V != reference.V || state.PC != reference.PC || state.I != reference.I) {
+            std::printf("  %-18s ERRO: estado final diverge da árvore de switches\n", v.name);
+            ok = false;
+            continue;
+        }
+        std::printf("  %-18s %7.3f ns/instr  %8.1f MIPS  %5.2fx\n", v.name, ns, 1e3 / ns, baseline / ns);
+    }
+    return ok ? 0 : 1;
+}
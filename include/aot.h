@@ -0,0 +1,110 @@
+// Recompilação estática (AOT) do Chip-8
+// O chip8-aot percorre o grafo de fluxo de uma ROM e gera uma unidade de tradução C++ com uma
+// função por bloco básico; ligada ao núcleo, ela se registra e vira o motor CpuBackend::Aot.
+// ALU, I, timers, desvios e pilha viram C++; instruções com E/S ou escrita na memória chamam
+// o interpretador (AotContext::exec). PCs sem bloco, blocos cujos bytes na RAM já não são os
+// da ROM (código auto-modificável) e o fim do orçamento do quadro rodam no interpretador.
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <cstring>
+#include <vector>
+#include "config.h"
+#include "memory.h"
+#include "cpu.h"
+
+// Estado visto pelo código gerado
+class AotContext {
+public:
+    AotContext(CPU& cpu, CpuState& state, const uint8_t* ram) : state(state), ram(ram), cpu(cpu) {}
+
+    CpuState& state;
+    const uint8_t* ram; // Leituras diretas (FX65 dentro de 0x000-0xFFF)
+
+    // Copia V e I para as variáveis locais do bloco (o compilador as mantém em registradores,
+    // sem recarregar a cada escrita de byte) e de volta
+    void load(uint8_t* V, uint16_t& I) const {
+        std::memcpy(V, state.V.data(), 16);
+        I = state.I;
+    }
+    void store(const uint8_t* V, uint16_t I) {
+        std::memcpy(state.V.data(), V, 16);
+        state.I = I;
+    }
+
+    // Executa opcode no interpretador com o PC já avançado para next_pc (V e I já gravados)
+    void exec(uint16_t opcode, uint16_t next_pc);
+
+private:
+    CPU& cpu;
+};
+
+// Bloco básico gerado: instructions opcodes a partir de pc, bytes bytes na ROM
+struct AotBlock {
+    uint16_t pc;
+    uint16_t bytes;
+    uint16_t instructions;
+    uint16_t jump;               // Endereço do 1NNN que encerra o bloco (0 = outro final)
+    void (*run)(AotContext& c);  // Executa o bloco inteiro e deixa o PC no sucessor
+};
+
+// Programa gerado para uma ROM
+struct AotProgram {
+    const char* name;
+    uint16_t load_address;
+    const uint8_t* image;  // Bytes da ROM (referência para conferir a RAM)
+    uint16_t image_size;
+    const AotBlock* blocks;
+    uint16_t block_count;
+};
+
+// Registra um programa na carga do executável (objeto estático na unidade gerada)
+struct AotRegistration {
+    explicit AotRegistration(const AotProgram& program);
+};
+
+class Aot {
+public:
+    Aot(CPU& cpu, const AotProgram& program);
+
+    Aot(const Aot&) = delete;
+    Aot& operator=(const Aot&) = delete;
+
+    // Programa registrado cuja ROM está carregada em ram (nullptr se nenhum)
+    static const AotProgram* find_program(const std::array<uint8_t, Memory::MEMORY_SIZE>& ram);
+
+    // Executa até max_cycles instruções; retorna quantas foram executadas
+    int run(int max_cycles);
+
+    // Escrita em [address, address + length): os blocos nesse trecho são conferidos de novo
+    void invalidate(uint16_t address, uint16_t length);
+
+private:
+    friend struct AotRegistration;
+
+    static constexpr int CHUNK = 64; // Granularidade da invalidação (um bloco ocupa no máximo dois)
+
+    struct Entry {
+        const AotBlock* block = nullptr;
+        uint32_t seen = ~0u;     // Soma das gerações dos trechos do bloco na última conferência
+        bool valid = false;      // Bytes na RAM iguais aos da ROM
+        bool idle_loop = false;  // O JP final fecha um laço candidato a ocioso
+    };
+
+    CPU& cpu;
+    const AotProgram& program;
+    AotContext context;
+
+    // Blocos indexados pelo PC inicial
+    std::array<Entry, Memory::MEMORY_SIZE> entries;
+
+    // Contador de escritas por trecho de CHUNK bytes
+    std::array<uint32_t, Memory::MEMORY_SIZE / CHUNK> generation{};
+
+    // Programas ligados ao executável
+    static std::vector<const AotProgram*>& registry();
+
+    // Confere (se houve escrita desde a última vez) se o bloco da entrada pode rodar
+    bool is_current(Entry& entry);
+};
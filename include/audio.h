@@ -1,22 +1,18 @@
 // Módulo de áudio do Chip-8
-// Simula o beep usando SDL2
+// Interface de saída das amostras; implementada pelo SDL2 (SdlAudio), por arquivo WAV
+// (WavAudio) ou pelo backend nulo (NullAudio). As amostras são geradas pelo AudioSynth
 
 #pragma once
-#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
 
 class Audio {
 public:
-    Audio();
-    ~Audio();
+    virtual ~Audio() = default;
 
-    // Inicia a reprodução do beep
-    void start_beep();
+    // Recebe as amostras de um quadro emulado (mono, 16 bits, Config::Audio::SAMPLE_RATE)
+    virtual void queue_samples(const int16_t* samples, size_t count) = 0;
 
-    // Interrompe o beep
-    void stop_beep();
-
-private:
-    SDL_AudioDeviceID device;
-    bool is_playing;
-    static void audio_callback(void* userdata, Uint8* stream, int len);
+    // false: a saída descarta tudo e o núcleo nem chega a gerar as amostras
+    virtual bool is_enabled() const { return true; }
 };
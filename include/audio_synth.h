@@ -0,0 +1,36 @@
+// Sintetizador do beep do Chip-8
+// Gera, a cada quadro emulado, as amostras do quadro a partir de uma tabela de onda
+// pré-calculada; a quantidade vem da linha do tempo emulada, não do relógio do host
+
+#pragma once
+#include "config.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class AudioSynth {
+public:
+    AudioSynth();
+
+    // Gera as amostras do próximo quadro; tone_on = sound timer ativo no quadro
+    // Retorna quantas amostras foram escritas em data()
+    size_t render_frame(bool tone_on);
+
+    // Amostras do último quadro gerado
+    const int16_t* data() const { return buffer.data(); }
+
+    // Volta ao início da linha do tempo (fase e volume zerados)
+    void reset();
+
+private:
+    using Wavetable = std::array<int16_t, Config::Audio::WAVETABLE_SIZE>;
+
+    // Um período da onda quadrada com banda limitada (harmônicas ímpares abaixo de Nyquist)
+    static const Wavetable& wavetable();
+
+    uint64_t frame = 0;    // Quadros emulados já gerados
+    uint32_t phase = 0;    // Acumulador de fase (32 bits = um período)
+    int gain = 0;          // Volume atual, de 0 a RAMP_SAMPLES
+    std::vector<int16_t> buffer;
+};
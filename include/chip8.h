@@ -6,41 +6,134 @@
 #include "memory.h"
 #include "display.h"
 #include "input.h"
-#include "audio.h"
+#include "platform.h"
 #include "cpu.h"
+#include "snapshot.h"
+#include "machine_state.h"
+#include "audio_synth.h"
 #include <string>
-#include <SDL2/SDL.h>
+#include <vector>
 
 class Chip8 {
 public:
-    Chip8();
+    // verbose = false silencia as mensagens informativas (execuções em lote)
+    explicit Chip8(bool verbose = true);
     ~Chip8();
 
-    // Inicializa todos os módulos
-    void initialize(int scale = Config::Display::DEFAULT_SCALE, int clock = Config::CPU::DEFAULT_CLOCK_SPEED);
+    // Inicializa todos os módulos; da plataforma (SDL ou nula) só usa a saída de áudio, pois
+    // eventos e apresentação ficam com a thread da plataforma (ver HostLink)
+    void initialize(Platform& platform, int clock = Config::CPU::DEFAULT_CLOCK_SPEED);
 
     // Carrega uma ROM no endereço especificado
     bool load_rom(const std::string& path, uint16_t load_address = Config::Memory::PROGRAM_START);
 
+    // Carrega uma ROM já lida (a mesma imagem pode ser compartilhada entre instâncias)
+    bool load_rom(const std::vector<uint8_t>& data, uint16_t load_address = Config::Memory::PROGRAM_START);
+
+    // Define a semente do gerador pseudoaleatório (CXKK)
+    void set_seed(uint32_t seed);
+
+    // Copia o estado completo da máquina para snapshot
+    void save_state(Snapshot& snapshot) const;
+
+    // Restaura o estado completo da máquina (sem recarregar a ROM)
+    void load_state(const Snapshot& snapshot);
+
+    // Estado emulado completo; copiar a estrutura clona a máquina (ex.: nós de busca em árvore)
+    const MachineState& get_state() const { return state; }
+
+    // Clona o estado emulado em out (uma cópia, sem alocação)
+    void save_state(MachineState& out) const { out = state; }
+
+    // Restaura um clone; só os bytes de RAM que mudaram invalidam o cache de instruções e o
+    // JIT (sem contar como código auto-modificável), então alternar entre clones da mesma ROM
+    // mantém o código decodificado e compilado
+    void load_state(const MachineState& in);
+
+    // Liga/desliga o salto de laços ociosos
+    void set_idle_skip(bool enabled);
+
+    // Instruções de laços ociosos contadas sem executar (incluídas no retorno de run_frame)
+    uint64_t get_idle_cycles() const;
+
+    // Liga/desliga a fusão de sequências comuns de opcodes no interpretador (ligada por padrão)
+    void set_fusion(bool enabled);
+
+    // Execuções de cada sequência fundida (indexado por Fusion, nomes em FUSION_NAMES)
+    std::array<uint64_t, FUSION_COUNT> get_fusion_hits() const;
+
+    // Blocos do JIT marcados para o interpretador (0 sem JIT); restaurar estados não os aumenta
+    int get_jit_interpreted_blocks() const;
+
+    // Liga/desliga o trace de execução (ver Tracer::open_file)
+    void set_exec_trace(bool enabled);
+
+    // Liga o profiler (nullptr desliga); o objeto precisa viver enquanto a CPU executar
+    void set_profiler(Profiler* profiler);
+
+    // Pressiona ou solta uma tecla Chip-8 (ex.: scripts de entrada)
+    void set_key(uint8_t key, bool pressed) { input.set_key(key, pressed); }
+
+    // Estado das 16 teclas (bit k = tecla k), ex.: gravação de filmes
+    uint16_t get_key_mask() const { return input.get_key_mask(); }
+
+    // Teclas pressionadas desde o último quadro que as consumiu (ex.: gravação de filmes)
+    uint16_t get_key_presses() const { return input.get_presses(); }
+
+    // Aplica teclas vindas de outra thread: mask = estado atual, presses = teclas pressionadas
+    // desde o último envio (um toque que já terminou ainda chega ao FX0A)
+    void apply_keys(uint16_t mask, uint16_t presses);
+
+    // CPU parada em FX0A; com os timers zerados (quiescente), nenhum quadro muda o estado
+    // até chegar uma tecla e o escalonador pode dormir em vez de emular
+    bool is_waiting_for_key() const;
+    bool is_quiescent() const;
+
     // Executa um ciclo de CPU
     void emulate_cycle();
 
+    // Executa até n ciclos de CPU de uma vez; retorna quantos foram executados
+    int run_cycles(int n);
+
+    // Seleciona o motor de execução da CPU (interpretador ou JIT)
+    bool set_cpu_backend(CpuBackend backend);
+
     // Atualiza timers 
     void update_timers();
 
-    // Processa eventos de teclado
-    void handle_input(const SDL_Event& event);
+    // Define quantas instruções são executadas por quadro de 60 Hz
+    void set_instructions_per_frame(int ipf);
+    int get_instructions_per_frame() const { return instructions_per_frame; }
+
+    // Executa um quadro emulado: as instruções do quadro, um tick dos timers e as
+    // amostras de áudio do quadro. Retorna o número de instruções executadas
+    int run_frame();
+
+    // Acrescenta uma saída de áudio além da plataforma (ex.: WavAudio); precisa viver
+    // enquanto a CPU executar
+    void add_audio_output(Audio& output);
 
-    // Atualiza o display
-    void draw();
+    // Copia o framebuffer para rows se ele mudou desde a última cópia (apresentação em
+    // outra thread); retorna false se não mudou
+    bool take_frame(std::array<uint64_t, Display::HEIGHT>& rows);
+
+    // Framebuffer atual (ex.: hash ao fim de uma execução headless)
+    const Display& get_display() const { return display; }
 
 private:
+    MachineState state; // Todo o estado emulado; os módulos abaixo são visões sobre ele
     Memory memory;
-    Display* display;
+    Display display;
     Input input;
-    Audio audio;
     CPU* cpu;
-    int scale;
     int clock_speed;
+    int instructions_per_frame;
     bool initialized;
+
+    // Áudio: gerado por quadro e entregue às saídas habilitadas (plataforma e extras)
+    AudioSynth synth;
+    std::vector<Audio*> audio_outputs;
+
+    // Gera as amostras do quadro e entrega às saídas (nada se todas estiverem desligadas)
+    void render_audio(bool tone_on);
 };
@@ -0,0 +1,62 @@
+/* API C do ambiente vetorizado (VecEnv), exportada por libchip8_vec_env (make vec-env)
+ * N instâncias headless da mesma ROM avançadas em lote; os buffers de observação são
+ * contíguos e têm endereço fixo até chip8_vec_env_destroy, para mapeamento sem cópia
+ * (ex.: numpy.ctypeslib.as_array). Nenhuma função é segura para chamadas concorrentes no
+ * mesmo ambiente; o paralelismo fica dentro de chip8_vec_env_step. */
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(CHIP8_VEC_ENV_BUILD)
+#define CHIP8_VEC_ENV_API __declspec(dllexport)
+#else
+#define CHIP8_VEC_ENV_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct chip8_vec_env chip8_vec_env;
+
+/* Motores da CPU (backend em chip8_vec_env_create) */
+#define CHIP8_VEC_ENV_INTERP 0
+#define CHIP8_VEC_ENV_JIT 1
+
+/* Cria num_envs instâncias da ROM; a instância i usa a semente seed + i. ipf = 0 usa o clock
+ * padrão; threads = 0 usa todos os núcleos. Retorna NULL (com mensagem) em caso de erro */
+CHIP8_VEC_ENV_API chip8_vec_env* chip8_vec_env_create(const uint8_t* rom, size_t rom_size, int num_envs,
+                                                      uint32_t seed, int ipf, int backend, unsigned threads);
+
+/* Libera o ambiente e os buffers de observação */
+CHIP8_VEC_ENV_API void chip8_vec_env_destroy(chip8_vec_env* env);
+
+/* Número de instâncias */
+CHIP8_VEC_ENV_API int chip8_vec_env_num_envs(const chip8_vec_env* env);
+
+/* Volta todas as instâncias ao estado inicial; seeds (num_envs valores) pode ser NULL */
+CHIP8_VEC_ENV_API void chip8_vec_env_reset(chip8_vec_env* env, const uint32_t* seeds);
+
+/* Volta uma instância ao estado inicial; retorna 0, ou -1 se o índice é inválido */
+CHIP8_VEC_ENV_API int chip8_vec_env_reset_one(chip8_vec_env* env, int index, uint32_t seed);
+
+/* Avança todas as instâncias frames quadros com as teclas key_masks[i] seguradas (bit k =
+ * tecla k; NULL solta todas); retorna 0, ou -1 se frames é negativo */
+CHIP8_VEC_ENV_API int chip8_vec_env_step(chip8_vec_env* env, const uint16_t* key_masks, int frames);
+
+/* Bytes do framebuffer de uma instância (32 linhas x 8 bytes, bit 7 do byte 0 = coluna 0) */
+CHIP8_VEC_ENV_API size_t chip8_vec_env_frame_bytes(void);
+
+/* num_envs x chip8_vec_env_frame_bytes() bytes; numpy.unpackbits(..., axis=-1) dá N x 32 x 64 */
+CHIP8_VEC_ENV_API const uint8_t* chip8_vec_env_framebuffers(const chip8_vec_env* env);
+
+/* num_envs bytes: 1 se o sound timer está ativo ao fim do último passo */
+CHIP8_VEC_ENV_API const uint8_t* chip8_vec_env_sound(const chip8_vec_env* env);
+
+/* num_envs bytes: 1 se a instância está parada em FX0A esperando uma tecla */
+CHIP8_VEC_ENV_API const uint8_t* chip8_vec_env_waiting(const chip8_vec_env* env);
+
+#ifdef __cplusplus
+}
+#endif
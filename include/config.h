@@ -3,6 +3,7 @@
 
 #pragma once
 #include <cstdint>
+#include <cstddef>
 
 // Configurações de Display
 namespace Config {
@@ -10,6 +11,8 @@ namespace Config {
         constexpr int WIDTH = 64;              // Largura da tela em pixels
         constexpr int HEIGHT = 32;             // Altura da tela em pixels
         constexpr int DEFAULT_SCALE = 10;      // Fator de escala padrão 
+        constexpr uint32_t COLOR_ON = 0xFFFFFFFF;  // Pixel aceso (ARGB, branco)
+        constexpr uint32_t COLOR_OFF = 0xFF000000; // Pixel apagado (ARGB, preto)
     }
 
     // Configurações de Memória
@@ -24,17 +27,36 @@ namespace Config {
     // Configurações de Áudio
     namespace Audio {
         constexpr int SAMPLE_RATE = 44100;     // Taxa de amostragem (Hz)
-        constexpr int AMPLITUDE = 128;         // Amplitude do som
+        constexpr int AMPLITUDE = 6000;        // Amplitude do som (amostras de 16 bits)
         constexpr int FREQUENCY = 440;         // Frequência do beep (Hz)
         constexpr int CHANNELS = 1;            // Mono
-        constexpr int BUFFER_SIZE = 1024;      // Tamanho do buffer de áudio
+        constexpr int BUFFER_SIZE = 512;       // Tamanho do buffer do dispositivo (amostras)
+        constexpr int WAVETABLE_SIZE = 1024;   // Amostras de um período da onda pré-calculada (potência de 2)
+        constexpr int RAMP_SAMPLES = 64;       // Rampa de volume ao ligar/desligar o beep (evita estalos)
+        constexpr int MAX_QUEUED_FRAMES = 6;   // Quadros de áudio na fila antes de descartar (acelerado)
     }
 
     // Configurações de CPU
     namespace CPU {
         constexpr int DEFAULT_CLOCK_SPEED = 500;  // Velocidade padrão (Hz)
-        constexpr int TIMER_FREQUENCY = 60;       // Frequência dos timers (Hz)
+        constexpr int TIMER_FREQUENCY = 60;       // Frequência dos timers (Hz) e dos quadros emulados
+        constexpr int MAX_FRAME_LAG = 5;          // Quadros de atraso tolerados antes de ressincronizar
         constexpr int STACK_SIZE = 16;            // Tamanho da pilha
         constexpr int NUM_REGISTERS = 16;         // Número de registradores (V0-VF)
+        constexpr int MAX_IDLE_LOOP = 8;          // Instruções no maior laço ocioso reconhecido
+        constexpr int QUIESCENT_WAIT_MS = 100;    // Sono máximo com a máquina parada em FX0A (redesenho)
+    }
+
+    // Configurações do rebobinar (rewind)
+    namespace Rewind {
+        constexpr int DEFAULT_SECONDS = 10;             // Histórico padrão no modo com janela
+        constexpr size_t BUFFER_BYTES = 4 * 1024 * 1024; // Memória máxima dos deltas
+    }
+
+    // Configurações do trace assíncrono
+    namespace Trace {
+        constexpr size_t RING_EVENTS = 4096;        // Eventos por anel (um anel por CPU)
+        constexpr int MESSAGES_PER_SECOND = 10;     // Diagnósticos impressos por tipo a cada segundo
+        constexpr int DRAIN_INTERVAL_MS = 5;        // Período da thread de drenagem
     }
 }
@@ -4,15 +4,46 @@
 #pragma once
 #include <cstdint>
 #include <array>
+#include <memory>
 #include "config.h"
+#include "opcodes.h"
 #include "memory.h"
 #include "display.h"
 #include "input.h"
-#include "audio.h"
+#include "rng.h"
+#include "trace.h"
+#include "profiler.h"
+
+class Jit;
+class Aot;
+class AotContext;
+
+// Motor de execução da CPU
+enum class CpuBackend {
+    Interpreter,  // Interpretador com cache de decodificação
+    Jit,          // Recompilador dinâmico x86-64
+    Aot           // Programa gerado pelo chip8-aot e ligado ao executável (ver aot.h)
+};
+
+// Registradores, pilha, timers e gerador da CPU (parte de MachineState; a CPU é uma visão sobre ele)
+struct CpuState {
+    std::array<uint8_t, 16> V;
+    uint16_t I;
+    uint16_t PC;
+    uint8_t SP;
+    std::array<uint16_t, 16> stack;
+    uint8_t delay_timer;
+    uint8_t sound_timer;
+    uint32_t rng_state;
+    uint16_t key_wait_held;      // FX0A: teclas já seguradas ao entrar na espera
+    uint16_t key_wait_pressed;   // FX0A: teclas pressionadas durante a espera
+    int8_t key_wait_reg;         // FX0A: registrador de destino (-1 = sem espera)
+};
 
 class CPU {
 public:
-    CPU(Memory& memory, Display& display, Input& input, Audio& audio);
+    // Liga a CPU aos registradores em state e aos módulos; reinicia os registradores
+    CPU(CpuState& state, Memory& memory, Display& display, Input& input);
     ~CPU();
 
     // Reinicia a CPU para o estado inicial
@@ -21,41 +52,168 @@ public:
     // Executa um ciclo de instrução (fetch-decode-execute)
     void emulate_cycle();
 
+    // Executa até max_cycles instruções no motor selecionado; retorna quantas foram executadas
+    int run(int max_cycles);
+
+    // Seleciona o motor de execução; retorna false se não houver suporte no host (ou, no AOT,
+    // se nenhum programa ligado ao executável corresponder à ROM carregada)
+    bool set_backend(CpuBackend backend);
+
     // Atualiza os timers 
     void update_timers();
 
+    // Sound timer ativo (o beep soa enquanto for diferente de zero)
+    bool is_sound_active() const { return state.sound_timer > 0; }
+
+    // Parada em FX0A esperando uma tecla ser pressionada e solta
+    bool is_waiting_for_key() const { return state.key_wait_reg >= 0; }
+
+    // Em FX0A com os dois timers zerados: nenhum quadro muda nada até chegar uma tecla
+    bool is_quiescent() const { return state.key_wait_reg >= 0 && state.delay_timer == 0 && state.sound_timer == 0; }
+
     // Define a velocidade do clock
     void set_clock_speed(int hz);
 
-private:
-    // Registradores
-    std::array<uint8_t, 16> V;  // V0-VF
-    uint16_t I;                  // Registrador de endereço
-    uint16_t PC;                 // Contador de programa
-    uint8_t SP;                  // Ponteiro de pilha
+    // Define a semente do gerador usado por CXKK
+    void set_seed(uint32_t seed);
 
-    // Pilha
-    std::array<uint16_t, 16> stack;
+    // Copia os registradores para out
+    void save_state(CpuState& out) const;
 
-    // Timers
-    uint8_t delay_timer;
-    uint8_t sound_timer;
+    // Restaura os registradores de in
+    void load_state(const CpuState& in);
+
+    // Liga/desliga o salto de laços ociosos (espera por timer ou tecla)
+    void set_idle_skip(bool enabled);
+
+    // Instruções de laços ociosos contadas sem executar
+    uint64_t get_idle_cycles() const { return idle_cycles; }
+
+    // Liga/desliga a fusão de sequências comuns em superinstruções do interpretador
+    void set_fusion(bool enabled);
+
+    // Execuções de cada sequência fundida (indexado por Fusion)
+    const std::array<uint64_t, FUSION_COUNT>& get_fusion_hits() const { return fusion_hits; }
+
+    // Blocos do JIT que voltaram ao interpretador (0 fora do JIT)
+    int get_jit_interpreted_blocks() const;
+
+    // Liga/desliga o trace de execução (um evento por instrução, sem JIT nem salto de laços)
+    void set_exec_trace(bool enabled) { exec_trace = enabled; }
+
+    // Liga o profiler (nullptr desliga); com ele, run usa o interpretador instrumentado (com o
+    // trace de execução ligado, o laço do trace alimenta o profiler)
+    void set_profiler(Profiler* profiler) { this->profiler = profiler; }
+
+private:
+    friend class Jit;
+    friend class Aot;
+    friend class AotContext;
+
+    // Registradores, pilha, timers e espera do FX0A (o PC fica na instrução até uma tecla ser solta)
+    CpuState& state;
 
     // Referências aos módulos
     Memory& memory;
     Display& display;
     Input& input;
-    Audio& audio;
 
     // Instruções por segundo
     int clock_speed;
 
-    // Decodifica e executa um opcode
+    // Gerador pseudoaleatório da instância (CXKK), sobre state.rng_state
+    Rng rng;
+
+    // Salto de laços ociosos
+    bool idle_skip = true;
+    uint64_t idle_cycles = 0;
+
+    // Fusão de instruções (só no interpretador sem profiler; o JIT já compila blocos inteiros)
+    bool fusion = true;
+    std::array<uint64_t, FUSION_COUNT> fusion_hits{};
+
+    // Diagnósticos e trace de execução (drenados fora da thread da CPU)
+    TraceRing trace;
+    bool exec_trace = false;
+
+    // Contadores de execução (nullptr = sem profiling)
+    Profiler* profiler = nullptr;
+
+    // Recompilador dinâmico (nullptr = interpretador)
+    std::unique_ptr<Jit> jit;
+
+    // Programa recompilado estaticamente (nullptr = sem AOT)
+    std::unique_ptr<Aot> aot;
+
+    // Instrução pré-decodificada: operandos extraídos e ponteiro direto para o handler
+    struct DecodedInstruction;
+    using Handler = void (*)(CPU& cpu, const DecodedInstruction& d);
+
+    struct DecodedInstruction {
+        Handler handler;   // nullptr = entrada inválida
+        uint16_t opcode;
+        uint16_t nnn;
+        uint8_t x;
+        uint8_t y;
+        uint8_t n;
+        uint8_t kk;
+        Op op;
+        bool idle_loop;    // JP que fecha um laço candidato a ocioso
+        uint8_t label;     // Rótulo do laço do interpretador: op, ou OP_COUNT + Fusion
+    };
+
+    // Bytes lidos a partir do PC para decidir uma fusão (a mais longa tem três instruções)
+    static constexpr int FUSION_SPAN = 6;
+
+    // Cache de instruções decodificadas, indexado pelo PC
+    std::array<DecodedInstruction, Memory::MEMORY_SIZE> decode_cache;
+
+    // Tabela Op -> handler, gerada a partir de CHIP8_OPCODES
+    static const std::array<Handler, OP_COUNT> HANDLERS;
+
+    // Executa a operação K (uma especialização por operação em cpu.cpp); regs é o próprio
+    // state, recebido como parâmetro para o laço do interpretador mantê-lo em registrador
+    // (sem isso, cada escrita em V obriga a recarregar a referência a partir de this)
+    template <Op K> void exec(CpuState& regs, const DecodedInstruction& d);
+
+    // Ponte estática para exec<K>, usada na tabela de handlers
+    template <Op K> static void handler(CPU& cpu, const DecodedInstruction& d) { cpu.exec<K>(cpu.state, d); }
+
+    // Retorna a instrução decodificada em pc, decodificando em caso de falta no cache
+    inline const DecodedInstruction& fetch(uint16_t pc);
+
+    // Laço do interpretador com despacho por tabela (Profile = alimenta o profiler)
+    template <bool Profile> int run_interpreter(int max_cycles);
+
+    // Executa instrução por instrução, registrando cada uma no trace (e no profiler, se ligado)
+    int run_traced(int max_cycles);
+
+    // Confere a espera do FX0A contra as teclas atuais; true se uma tecla foi solta e a espera acabou
+    bool resolve_key_wait();
+
+    // FX0A em espera: conta as remaining instruções restantes do quadro como ociosas e as retorna
+    int idle_key_wait(int remaining);
+
+    // Decodifica e executa um opcode (sem passar pelo cache)
     void execute_opcode(uint16_t opcode);
 
-    // Funções auxiliares para grupos de opcodes
-    void execute_0xxx(uint16_t opcode);
-    void execute_8xxx(uint16_t opcode);
-    void execute_Exxx(uint16_t opcode);
-    void execute_Fxxx(uint16_t opcode);
+    // Decodifica um opcode, extraindo operandos e escolhendo o handler
+    static DecodedInstruction decode(uint16_t opcode);
+
+    // Sequência que começa na instrução first, em pc, e pode ser executada fundida; decodifica
+    // também as instruções seguintes (o laço do interpretador as lê direto do cache)
+    Fusion detect_fusion(uint16_t pc, const DecodedInstruction& first);
+
+    // Indica se o JP em pc para target fecha um laço só com instruções sem efeito colateral
+    bool is_idle_loop_candidate(uint16_t pc, uint16_t target) const;
+
+    // Após um JP candidato: se o laço em PC é um ponto fixo até o próximo quadro,
+    // retorna quantas instruções (iterações inteiras que cabem em remaining) podem ser puladas
+    int skip_idle_loop(int remaining);
+    static int skip_idle_loop_helper(CPU& cpu, int remaining) { return cpu.skip_idle_loop(remaining); }
+
+    // Invalida as entradas do cache que cobrem [address, address + length); source diz se a
+    // escrita veio do programa (conta para o JIT desistir de blocos auto-modificáveis)
+    void invalidate_cache(uint16_t address, uint16_t length, WriteSource source = WriteSource::Host);
+    static void on_memory_write(void* userdata, uint16_t address, uint16_t length, WriteSource source);
 };
@@ -1,19 +1,24 @@
 // Módulo de saída gráfica do Chip-8
-// Responsável por renderizar a tela 64x32 usando SDL2
+// Framebuffer 64x32 empacotado em bits; a apresentação fica a cargo da plataforma
 
 #pragma once
 #include <cstdint>
-#include <vector>
-#include <SDL2/SDL.h>
+#include <array>
 #include "config.h"
 
+// Estado do display (parte de MachineState; o Display é só uma visão sobre ele)
+// As linhas sujas são do host (apresentação) e ficam no Display, fora do estado clonado
+struct DisplayState {
+    std::array<uint64_t, Config::Display::HEIGHT> rows; // Framebuffer 64x32 (1 bit por pixel)
+};
+
 class Display {
 public:
     static constexpr int WIDTH = Config::Display::WIDTH;
     static constexpr int HEIGHT = Config::Display::HEIGHT;
 
-    // Cria o display, inicializando SDL e a janela
-    Display(int scale = Config::Display::DEFAULT_SCALE);
+    // Liga o display ao estado dado e limpa a tela (todas as linhas ficam sujas)
+    explicit Display(DisplayState& state);
     ~Display();
 
     // Limpa a tela
@@ -22,17 +27,36 @@ public:
     // Desenha um sprite na tela na posição (x, y)
     bool draw_sprite(uint8_t x, uint8_t y, const uint8_t* sprite, uint8_t n);
 
-    // Atualiza a janela SDL com o estado atual dos pixels
-    void render();
+    // Retorna o estado de um pixel (coordenadas já dentro da tela)
+    bool get_pixel(int x, int y) const { return (state.rows[y] >> (WIDTH - 1 - x)) & 1; }
+
+    // Framebuffer empacotado: uma palavra de 64 bits por linha, bit 63 = coluna 0
+    const std::array<uint64_t, HEIGHT>& get_rows() const { return state.rows; }
+
+    // Substitui o framebuffer (restaurar estado); só as linhas diferentes ficam sujas
+    void set_rows(const std::array<uint64_t, HEIGHT>& value);
+
+    // Indica se o framebuffer mudou desde a última apresentação
+    bool is_dirty() const { return dirty_rows != 0; }
 
+    // Linhas alteradas desde a última apresentação (bit y = linha y)
+    uint32_t get_dirty_rows() const { return dirty_rows; }
+
+    // Marca o framebuffer como apresentado
+    void clear_dirty() { dirty_rows = 0; }
+
+    // Hash FNV-1a do framebuffer (comparação de execuções)
+    uint64_t hash() const;
 
 private:
-    int scale; // Fator de escala
-    std::vector<uint8_t> pixels; // Framebuffer 64x32
-    SDL_Window* window;
-    SDL_Renderer* renderer;
-    SDL_Texture* texture;
-
-    // Atualiza a textura SDL com o framebuffer
-    void update_texture();
+    DisplayState& state;
+
+    // Linhas alteradas desde a última apresentação (bit y = linha y)
+    uint32_t dirty_rows;
+
+    static_assert(HEIGHT <= 32, "dirty_rows guarda uma linha por bit");
+    static constexpr uint32_t ALL_ROWS = HEIGHT == 32 ? ~0u : (1u << HEIGHT) - 1;
+
+    // Aplica XOR das máscaras em count linhas consecutivas; retorna os bits que colidiram
+    static uint64_t xor_rows(uint64_t* dst, const uint64_t* masks, int count);
 };
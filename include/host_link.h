@@ -0,0 +1,84 @@
+// Canal entre a thread da plataforma (eventos e apresentação) e a thread de emulação
+// Teclas, comandos e quadros passam sem trava; só o sono da emulação em FX0A usa
+// mutex/condvar, para acordar assim que chegar entrada
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include "display.h"
+#include "platform.h"
+#include "trace.h"
+#include "triple_buffer.h"
+
+class HostLink {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Quadro pronto para apresentar
+    struct Frame {
+        std::array<uint64_t, Display::HEIGHT> rows;
+        uint64_t number;   // Quadro emulado que o produziu
+    };
+
+    // --- Plataforma -> emulação ---
+
+    // Estado das teclas (bit k = tecla k) e toques desde o último envio; when = quando a
+    // plataforma viu a mudança (latência entrada->quadro)
+    void post_keys(uint16_t mask, uint16_t presses, Clock::time_point when);
+
+    // Comando de atalho (F5/F9); false se a fila está cheia
+    bool post_command(HostCommand command);
+
+    void set_rewind_held(bool held);
+    void request_quit();
+
+    // --- Emulação ---
+
+    // Retira as teclas enviadas desde a última chamada; false se não houve mudança
+    bool take_keys(uint16_t& mask, uint16_t& presses, Clock::time_point& since);
+
+    bool next_command(HostCommand& command);
+    bool rewind_held() const { return rewind.load(std::memory_order_relaxed); }
+    bool quit_requested() const { return quit.load(std::memory_order_acquire); }
+
+    // Dorme até deadline ou até a plataforma mandar algo (teclas, comando, rewind, saída)
+    void wait_for_host(Clock::time_point deadline);
+
+    // Quadro a ser montado e publicado
+    Frame& back_frame() { return frames.back(); }
+    void publish_frame() { frames.publish(); }
+
+    // Fim da emulação (limite de quadros/ciclos ou pedido de saída)
+    void finish() { done.store(true, std::memory_order_release); }
+
+    // --- Emulação -> plataforma ---
+
+    // Traz o quadro mais recente; false se não há quadro novo
+    bool update_frame() { return frames.update(); }
+    const Frame& frame() const { return frames.front(); }
+
+    bool finished() const { return done.load(std::memory_order_acquire); }
+
+private:
+    static constexpr uint64_t KEYS_CHANGED = 1ull << 32;
+
+    // Bits 0-15: teclas; 16-31: toques acumulados; 32: mudança ainda não retirada
+    std::atomic<uint64_t> keys{0};
+    std::atomic<int64_t> key_time{0};   // Primeira mudança ainda não retirada (ns do Clock)
+    SpscRing<HostCommand, 16> commands;
+    std::atomic<bool> rewind{false};
+    std::atomic<bool> quit{false};
+    std::atomic<bool> done{false};
+    TripleBuffer<Frame> frames;
+
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    bool wake_pending = false;
+
+    // Acorda a emulação se estiver dormindo em wait_for_host
+    void notify();
+};
@@ -1,27 +1,41 @@
 // Módulo de entrada do Chip-8
-// Gerencia o teclado hexadecimal (16 teclas) e mapeia para teclas físicas
+// Guarda o estado do teclado hexadecimal (16 teclas); a plataforma informa as teclas físicas
 
 #pragma once
 #include <cstdint>
-#include <SDL2/SDL.h>
+
+// Estado do teclado (parte de MachineState; o Input é só uma visão sobre ele)
+struct InputState {
+    uint16_t keys;    // Bit k = tecla k pressionada
+    uint16_t presses; // Teclas pressionadas ainda não retiradas por take_presses
+};
 
 class Input {
 public:
-    Input();
+    // Liga o teclado ao estado dado, com todas as teclas soltas
+    explicit Input(InputState& state);
     ~Input();
 
-    // Processa evento de teclado SDL
-    void handle_event(const SDL_Event& e);
+    // Atualiza o estado de uma tecla Chip-8
+    void set_key(uint8_t key, bool pressed);
 
     // Verifica se uma tecla CHIP-8 está pressionada
     bool is_pressed(uint8_t key) const;
 
-    // Bloqueia até que o usuário pressione uma tecla válida
-    uint8_t wait_for_key();
+    // Estado das 16 teclas como máscara de bits (bit k = tecla k)
+    uint16_t get_key_mask() const;
+    void set_key_mask(uint16_t mask);
 
-private:
-    bool keys[16]; // Estado das teclas (true = pressionada)
+    // Retira as teclas pressionadas desde a última chamada (bit k = tecla k), mesmo as que
+    // já foram soltas: um toque entre dois quadros não se perde na espera do FX0A
+    // (Chip8::run_frame descarta o que sobrar ao fim de cada quadro)
+    uint16_t take_presses();
+    uint16_t get_presses() const { return state.presses; }
 
-    // Converte a tecla pressionada para o índice correspondente no teclado do Chip-8
-    int map_key(SDL_Keycode key) const;
+    // Mudanças de estado das teclas desde a criação (o escalonador detecta entrada nova)
+    uint64_t get_event_count() const { return event_count; }
+
+private:
+    InputState& state;
+    uint64_t event_count;
 };
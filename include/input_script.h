@@ -0,0 +1,49 @@
+// Script de entrada do Chip-8
+// Sequência de eventos de tecla indexados por quadro, para execuções headless reprodutíveis
+//
+// Formato (texto, uma entrada por linha, '#' inicia comentário):
+//     <quadro> <tecla hex 0-F> <down|up>
+// Ex.: "120 5 down" pressiona a tecla 5 antes do quadro 120.
+
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class InputScript {
+public:
+    struct Event {
+        uint64_t frame;   // Quadro antes do qual o evento é aplicado
+        uint8_t key;      // Tecla Chip-8 (0x0-0xF)
+        bool pressed;
+    };
+
+    // Lê o script de um arquivo; retorna false (com mensagem) se houver erro
+    bool load(const std::string& path);
+
+    // Lê eventos de um fluxo até o fim (name identifica a origem nas mensagens de erro)
+    bool read(std::istream& in, const std::string& name, int first_line = 1);
+
+    // Grava os eventos no mesmo formato texto
+    void write(std::ostream& out) const;
+
+    // Acrescenta um evento (frame não pode ser anterior ao último evento)
+    void add(uint64_t frame, uint8_t key, bool pressed) { events.push_back(Event{frame, key, pressed}); }
+
+    // Eventos ordenados por quadro
+    const std::vector<Event>& get_events() const { return events; }
+
+    // Aplica os eventos de frame a partir de *cursor (avança o cursor); set_key recebe (tecla, pressionada)
+    template <typename SetKey>
+    void apply(uint64_t frame, size_t& cursor, SetKey&& set_key) const {
+        while (cursor < events.size() && events[cursor].frame <= frame) {
+            set_key(events[cursor].key, events[cursor].pressed);
+            ++cursor;
+        }
+    }
+
+private:
+    std::vector<Event> events;
+};
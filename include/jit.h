@@ -0,0 +1,106 @@
+// Recompilador dinâmico (JIT) do Chip-8 para x86-64
+// Traduz trechos lineares de opcodes em código nativo e encadeia os blocos diretamente
+// Instruções com E/S são delegadas aos handlers do interpretador de dentro do bloco
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <vector>
+#include "config.h"
+#include "memory.h"
+#include "cpu.h"
+
+class Jit {
+public:
+    explicit Jit(CPU& cpu);
+    ~Jit();
+
+    Jit(const Jit&) = delete;
+    Jit& operator=(const Jit&) = delete;
+
+    // Indica se o host suporta o JIT (x86-64 com memória executável)
+    static bool is_supported();
+
+    // Executa até max_cycles instruções; retorna quantas foram executadas
+    int run(int max_cycles);
+
+    // Descarta os blocos que cobrem [address, address + length); counted = escrita do programa
+    // (restaurar estado e trocar opções descartam sem contar para MAX_INVALIDATIONS)
+    void invalidate(uint16_t address, uint16_t length, bool counted);
+
+    // Descarta todos os blocos compilados
+    void flush();
+
+    // Blocos marcados para o interpretador (primeira instrução não traduzível ou auto-modificável)
+    int interpreted_blocks() const;
+
+private:
+    static constexpr int MAX_BLOCK_INSTRUCTIONS = 32;      // Instruções por bloco
+    static constexpr size_t CODE_BUFFER_SIZE = 1 << 20;     // 1 MB de código nativo
+    static constexpr size_t MAX_BLOCK_CODE = 4096;          // Pior caso de código por bloco
+    static constexpr int MAX_INVALIDATIONS = 4;             // Blocos auto-modificáveis voltam ao interpretador
+
+    enum class BlockState : uint8_t { Empty, Compiled, Interpret };
+
+    struct Block {
+        BlockState state = BlockState::Empty;
+        uint8_t invalidations = 0;
+        uint16_t end = 0;                 // Primeiro byte após o bloco
+        uint8_t* code = nullptr;          // Ponto de entrada nativo
+        std::vector<uint8_t*> incoming;   // Saídas de outros blocos encadeadas a este
+    };
+
+    CPU& cpu;
+    uint8_t* code_buffer;
+    uint8_t* cursor;
+
+    // Rotinas fixas: entrada (ajusta registradores base) e saída (empacota PC e ciclos)
+    using EntryFn = uint64_t (*)(const uint8_t* code, uint32_t budget);
+    EntryFn entry;
+    uint8_t* exit_stub;
+
+    // Blocos indexados pelo endereço inicial
+    std::array<Block, Memory::MEMORY_SIZE> blocks;
+
+    // Quantos blocos cobrem cada byte da memória (invalidação O(1) fora do código)
+    std::array<uint8_t, Memory::MEMORY_SIZE> coverage;
+
+    // Saídas aguardando a compilação do bloco de destino
+    std::array<std::vector<uint8_t*>, Memory::MEMORY_SIZE> pending;
+
+    // Ponto de entrada por PC para saídas dinâmicas (RET, BNNN...); exit_stub se não compilado
+    std::array<const uint8_t*, Memory::MEMORY_SIZE> entry_table;
+
+    // Instruções decodificadas passadas aos handlers do interpretador
+    std::array<CPU::DecodedInstruction, Memory::MEMORY_SIZE> helper_args;
+
+    // Compila o bloco que começa em pc; retorna false se a primeira instrução não é traduzível
+    bool compile(uint16_t pc);
+
+    // Emite as rotinas de entrada e saída no início do buffer
+    void emit_stubs();
+
+    // Emite uma saída para target e a encadeia se o destino já estiver compilado
+    void emit_exit(uint16_t target);
+
+    // Emite uma saída para o PC atual da CPU, via entry_table
+    void emit_dynamic_exit();
+
+    // Emite a chamada ao handler do interpretador para a instrução em pc
+    void emit_helper_call(uint16_t pc, uint16_t opcode);
+
+    // Emite a verificação de laço ocioso antes do JP para target
+    void emit_idle_skip(uint16_t target);
+
+    // Aponta um salto rel32 para dest
+    static void patch(uint8_t* site, const uint8_t* dest);
+
+    // Descarta um único bloco; counted soma uma invalidação ao bloco
+    void drop_block(uint16_t pc, bool counted);
+
+    // Emissores de bytes
+    void emit8(uint8_t value) { *cursor++ = value; }
+    void emit16(uint16_t value);
+    void emit32(uint32_t value);
+    void emit64(uint64_t value);
+};
@@ -0,0 +1,154 @@
+// Interpretador em lockstep: até LANES instâncias da mesma ROM em lanes SIMD
+// V e timers de cada instância ocupam uma lane de vetores de 16 bytes (extensões de vetor do
+// GCC/Clang, um registrador SSE2 no x86-64). Enquanto os PCs concordam, cada opcode é
+// decodificado uma vez e executado em todas as lanes; numa divergência (salto condicional, RET,
+// BNNN), o grupo da vez é o das lanes com o menor PC, com máscara por lane, e as demais esperam
+// até serem alcançadas. DXYN, FX33, FX55 e FX65 acessam a RAM e o framebuffer de cada lane.
+//
+// A semântica é a do CPU (o interpretador escalar): mesmo estado final, laços ociosos pulados
+// da mesma forma e FX0A como estado de espera por lane. Endereços sempre dão a volta em 12 bits
+// (WrappedAccess) e opcodes inválidos ou erros de pilha não geram eventos de trace.
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <vector>
+#include "config.h"
+#include "display.h"
+#include "machine_state.h"
+
+class LockstepGroup {
+public:
+    static constexpr int LANES = 16;
+
+    // Grupo com lanes instâncias (1 a LANES) executando ipf instruções por quadro; as lanes
+    // começam zeradas, carregue cada uma com load_lane
+    LockstepGroup(int lanes, int ipf);
+
+    LockstepGroup(const LockstepGroup&) = delete;
+    LockstepGroup& operator=(const LockstepGroup&) = delete;
+
+    // Número de lanes em uso
+    int size() const { return lanes; }
+
+    // Copia uma máquina para a lane (ex.: o estado de boot de um Chip8 com a semente da lane)
+    void load_lane(int lane, const MachineState& state);
+
+    // Copia o estado da lane para out
+    void save_lane(int lane, MachineState& out) const;
+
+    // Pressiona ou solta uma tecla na lane (como Chip8::set_key)
+    void set_key(int lane, uint8_t key, bool pressed);
+
+    // Teclas da lane: mask = estado atual, presses = toques desde o último envio (como Chip8::apply_keys)
+    void apply_keys(int lane, uint16_t mask, uint16_t presses);
+
+    // Liga/desliga o salto de laços ociosos
+    void set_idle_skip(bool enabled) { idle_skip = enabled; }
+
+    // Executa um quadro em todas as lanes (instruções do quadro, toques e timers, como
+    // Chip8::run_frame); retorna as instruções de cada lane no quadro
+    int run_frame();
+
+    // Framebuffer da lane (ex.: hash)
+    const Display& get_display(int lane) const { return displays[lane]; }
+
+    // Instruções de laços ociosos contadas sem executar na lane
+    uint64_t get_idle_cycles(int lane) const { return idle_cycles[lane]; }
+
+    // Passos do grupo (um opcode despachado para uma ou mais lanes) e instruções executadas
+    // somando as lanes; a razão entre os dois mede quanto as lanes ficam convergentes
+    uint64_t get_issued() const { return issued; }
+    uint64_t get_executed() const { return executed; }
+
+private:
+    // Registradores de 8 bits: um vetor SSE2 por registrador, elemento l = lane l
+    using Lanes8 = uint8_t __attribute__((vector_size(LANES)));
+    using Mask8 = int8_t __attribute__((vector_size(LANES)));
+
+    static constexpr int CODE_BLOCK = 64; // Granularidade do controle de RAM divergente
+
+    static_assert(LANES <= 32, "as lanes também são guardadas como bits de um uint32_t");
+    static_assert(Config::Memory::SIZE / CODE_BLOCK <= 64, "um bit por bloco de RAM em um uint64_t");
+
+    // Registradores das lanes. V e timers ficam em vetores; os campos de 16 e 32 bits ficam em
+    // arrays por lane (vetores mais largos que um registrador SSE2 viram código escalar)
+    struct alignas(64) Regs {
+        Lanes8 V[16];
+        Lanes8 delay_timer;
+        Lanes8 sound_timer;
+        std::array<uint16_t, LANES> I;
+        std::array<uint16_t, LANES> PC;
+        std::array<uint8_t, LANES> SP;
+        std::array<uint32_t, LANES> rng;
+        std::array<uint16_t, LANES> keys;    // Teclas seguradas (bit k = tecla k)
+        std::array<uint16_t, LANES> presses; // Toques ainda não retirados no quadro
+    };
+
+    // Estado de cada lane acessado só por DXYN, CALL/RET, FX0A e memória
+    struct Lane {
+        std::array<uint16_t, 16> stack;
+        int8_t key_wait_reg;      // FX0A: registrador de destino (-1 = sem espera)
+        uint16_t key_wait_held;
+        uint16_t key_wait_pressed;
+        alignas(64) std::array<uint8_t, Config::Memory::SIZE> ram;
+    };
+
+    int lanes;
+    int ipf;
+    uint32_t used;        // Bits das lanes em uso
+    bool idle_skip = true;
+
+    Regs regs;
+    std::vector<Lane> lane;
+    std::array<DisplayState, LANES> screens;
+    std::vector<Display> displays;
+
+    // Blocos de RAM em que alguma lane difere da lane 0 (bit b = bloco b); um opcode em bloco
+    // compartilhado é o mesmo em todas as lanes e é lido uma vez só
+    uint64_t diverged_blocks = 0;
+    bool blocks_stale = true; // Recalcular diverged_blocks antes do próximo quadro
+
+    std::array<uint64_t, LANES> idle_cycles{};
+    uint64_t issued = 0;
+    uint64_t executed = 0;
+
+    // Executa até budget instruções em cada lane que não está parada em FX0A
+    void run_budget(uint16_t budget);
+
+    // Executa as lanes de group juntas a partir de pc por até run passos: termina antes se as
+    // lanes se separarem (PCs por lane já gravados), se o código diferir entre elas ou ao
+    // alcançar o PC de uma lane de others. Desconta os passos de remaining e ajusta laços
+    // ociosos e FX0A. Full = group contém todas as lanes em uso (sem máscara)
+    template <bool Full>
+    void run_group(uint32_t group, uint32_t others, uint16_t pc, int run, std::array<uint16_t, LANES>& remaining);
+
+    // Bits das lanes com o byte de máscara ligado (SSE2: movemask)
+    static uint32_t lane_bits(Mask8 m);
+
+    // Máscara com os bytes das lanes de bits ligados
+    static Mask8 lane_mask(uint32_t bits);
+
+    // Escrita de length bytes em I nas lanes de group: marca os blocos como divergentes, a não
+    // ser que todas as lanes em uso tenham escrito os mesmos bytes (same_bytes) no mesmo lugar
+    void track_write(uint32_t group, bool same_bytes, int length);
+
+    // Recalcula diverged_blocks comparando cada lane com a lane 0
+    void refresh_blocks();
+
+    // FX0A pendente na lane: confere as teclas atuais; true se uma tecla foi solta
+    bool resolve_key_wait(int l);
+
+    // Indica se o JP em pc para target fecha um laço ocioso candidato (RAM da lane l)
+    bool is_idle_loop_candidate(int l, uint16_t pc, uint16_t target) const;
+
+    // Após um JP candidato na lane l, com o laço em loop_pc: instruções que podem ser puladas
+    // (como CPU::skip_idle_loop)
+    int skip_idle_loop(int l, uint16_t loop_pc, int remaining) const;
+
+    // Lê o opcode em pc na lane l
+    uint16_t read_opcode(int l, uint16_t pc) const {
+        return static_cast<uint16_t>((lane[l].ram[pc & (Config::Memory::SIZE - 1)] << 8) |
+                                     lane[l].ram[(pc + 1) & (Config::Memory::SIZE - 1)]);
+    }
+};
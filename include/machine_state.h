@@ -0,0 +1,28 @@
+// Estado emulado completo da máquina Chip-8 em um único bloco
+// CPU, Memory, Display e Input são visões sobre as partes deste bloco; clonar uma máquina
+// (busca em árvore, rewind, execuções em lote) é copiar a estrutura, sem alocação
+//
+// Fora daqui ficam só dados derivados ou do host: cache de decodificação, blocos do JIT,
+// trace, profiler, áudio, linhas sujas da apresentação, contadores de eventos e de instruções
+// ociosas.
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <type_traits>
+#include "config.h"
+#include "cpu.h"
+#include "display.h"
+#include "input.h"
+
+struct alignas(64) MachineState {
+    CpuState cpu;         // Registradores, pilha, timers, gerador e espera do FX0A
+    InputState input;     // Teclas pressionadas e toques pendentes
+    DisplayState display; // Framebuffer
+
+    // RAM em linhas de cache próprias (é o que mais pesa na cópia)
+    alignas(64) std::array<uint8_t, Config::Memory::SIZE> ram;
+};
+
+static_assert(std::is_trivially_copyable<MachineState>::value, "MachineState é clonado como bytes");
+static_assert(sizeof(MachineState) % 64 == 0, "MachineState ocupa linhas de cache inteiras");
@@ -1,44 +1,107 @@
 // Módulo de gerenciamento de memória do Chip-8
 // Gerencia os 4KB de RAM, carrega ROMs e inicializa sprites hexadecimais
+//
+// O acesso da CPU (read/write) é parametrizado por uma política escolhida em tempo de compilação:
+//     WrappedAccess  release: endereço mascarado em 12 bits (wraparound), sem desvios nem E/S
+//     CheckedAccess  depuração: fora de 0x000-0xFFF lança std::out_of_range; escrita nos sprites avisa
+// Memory usa CheckedAccess quando compilado com -DCHIP8_CHECKED_MEMORY (make debug).
 
 #pragma once
 #include <cstdint>
 #include <string>
 #include <array>
+#include <vector>
 #include "config.h"
 
-class Memory {
+static_assert((Config::Memory::SIZE & (Config::Memory::SIZE - 1)) == 0, "A máscara de endereço exige RAM potência de 2");
+
+// Política de release: o endereço dá a volta nos 12 bits, como no barramento original
+struct WrappedAccess {
+    static uint16_t read_address(uint16_t address) { return address & (Config::Memory::SIZE - 1); }
+    static uint16_t write_address(uint16_t address) { return address & (Config::Memory::SIZE - 1); }
+};
+
+// Política de depuração: valida o endereço e mantém os diagnósticos (caminho frio em memory.cpp)
+struct CheckedAccess {
+    static uint16_t read_address(uint16_t address);
+    static uint16_t write_address(uint16_t address);
+};
+
+// Origem de uma escrita: o programa emulado (FX33/FX55) ou o host (ROM, restaurar estado)
+// Só escritas do programa contam como código auto-modificável
+enum class WriteSource : uint8_t { Guest, Host };
+
+template <typename Access>
+class BasicMemory {
 public:
+    // Callback chamado quando um trecho da memória é modificado
+    using WriteListener = void (*)(void* userdata, uint16_t address, uint16_t length, WriteSource source);
+
     static constexpr uint16_t MEMORY_SIZE = Config::Memory::SIZE;
     static constexpr uint16_t PROGRAM_START = Config::Memory::PROGRAM_START;
     static constexpr uint16_t FONT_START = Config::Memory::FONT_START;
     static constexpr uint16_t FONT_SIZE = Config::Memory::FONT_SIZE;
     static constexpr uint16_t RESERVED_END = Config::Memory::RESERVED_END;
 
-    // Inicializa a memória zerada e carrega os sprites hexadecimais
-    Memory();
+    // Liga a memória à RAM dada (parte de MachineState), zera e carrega os sprites hexadecimais
+    // verbose = false silencia as mensagens informativas (execuções em lote)
+    explicit BasicMemory(std::array<uint8_t, MEMORY_SIZE>& ram, bool verbose = true);
     
-    ~Memory();
+    ~BasicMemory();
 
     // Limpa toda a memória e recarrega os sprites
     void clear();
 
     // Lê um byte da memória no endereço especificado
-    uint8_t read(uint16_t address) const;
+    uint8_t read(uint16_t address) const { return ram[Access::read_address(address)]; }
 
     // Escreve um byte na memória no endereço especificado
-    void write(uint16_t address, uint8_t value);
+    void write(uint16_t address, uint8_t value) {
+        address = Access::write_address(address);
+        ram[address] = value;
+        notify_write(address, 1, WriteSource::Guest);
+    }
 
     // Carrega uma ROM do arquivo para a memória
     bool load_rom(const std::string& rom_path, uint16_t load_address = PROGRAM_START);
 
+    // Carrega uma ROM já lida para a memória
+    bool load_rom(const uint8_t* data, size_t size, uint16_t load_address = PROGRAM_START);
+
+    // Lê o conteúdo de um arquivo de ROM; retorna false em caso de erro
+    static bool read_rom_file(const std::string& rom_path, std::vector<uint8_t>& out);
+
     // Retorna o endereço inicial de um sprite hexadecimal
     uint16_t get_font_address(uint8_t digit) const;
 
+    // Conteúdo completo da RAM (salvar estado)
+    const std::array<uint8_t, MEMORY_SIZE>& get_ram() const { return ram; }
+
+    // Substitui toda a RAM (restaurar estado); avisa o observador só dos bytes que mudaram
+    void load_ram(const std::array<uint8_t, MEMORY_SIZE>& data);
+
+    // Registra quem deve ser avisado sobre escritas (ex.: cache de instruções da CPU)
+    void set_write_listener(WriteListener listener, void* userdata);
+
 
 private:
+    static constexpr uint16_t LOAD_BLOCK = 64; // Blocos iguais em load_ram são pulados com um memcmp
+
     // Array de 4KB representando a memória RAM do Chip-8
-    std::array<uint8_t, MEMORY_SIZE> ram;
+    std::array<uint8_t, MEMORY_SIZE>& ram;
+
+    // Mostra mensagens informativas (erros e avisos sempre aparecem)
+    bool verbose;
+
+    // Observador de escritas
+    WriteListener write_listener = nullptr;
+    void* write_listener_data = nullptr;
+
+    // Avisa o observador que [address, address + length) foi modificado (inline: está no
+    // caminho de write, usado por FX33/FX55)
+    void notify_write(uint16_t address, uint16_t length, WriteSource source) {
+        if (write_listener) write_listener(write_listener_data, address, length, source);
+    }
 
     // Carrega os sprites hexadecimais na área reservada da memória
     void load_fonts();
@@ -47,3 +110,13 @@ private:
     bool is_valid_address(uint16_t address) const;
 };
 
+extern template class BasicMemory<WrappedAccess>;
+extern template class BasicMemory<CheckedAccess>;
+
+// Política usada pelo emulador (todas as unidades de um executável precisam concordar)
+#ifdef CHIP8_CHECKED_MEMORY
+using Memory = BasicMemory<CheckedAccess>;
+#else
+using Memory = BasicMemory<WrappedAccess>;
+#endif
+
@@ -0,0 +1,54 @@
+// Filmes do Chip-8 (gravação e reprodução determinística)
+// Semente do gerador, parâmetros de execução e as mudanças de tecla indexadas por quadro
+//
+// Como os timers andam um tick por quadro emulado e o gerador é por instância, esses dados
+// bastam para reproduzir uma execução bit a bit, sem janela e sem esperar pelo relógio.
+//
+// Formato (texto; o cabeçalho termina na linha "events"):
+//     chip8-movie 1
+//     seed <u32>
+//     ipf <n>
+//     loadaddr <hex>
+//     rom <hash hex>       FNV-1a 64 da imagem da ROM
+//     frames <n>           quadros gravados
+//     hash <hex>           hash do framebuffer ao fim da gravação
+//     events
+//     <quadro> <tecla hex 0-F> <down|up>     (mesmo formato de InputScript)
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "config.h"
+#include "input_script.h"
+
+class Movie {
+public:
+    static constexpr int VERSION = 1;
+
+    uint32_t seed = 1;
+    int instructions_per_frame = 0;
+    uint16_t load_address = Config::Memory::PROGRAM_START;
+    uint64_t rom_hash = 0;
+    uint64_t frames = 0;
+    uint64_t final_hash = 0;
+
+    // Hash da imagem da ROM, para conferir se a reprodução usa a mesma ROM
+    static uint64_t hash_rom(const std::vector<uint8_t>& rom);
+
+    // Gravação: registra as teclas que mudaram desde o quadro anterior; presses são as
+    // teclas pressionadas no intervalo (Input), para reproduzir também toques mais curtos
+    // que um quadro, que o FX0A enxerga
+    void record(uint64_t frame, uint16_t key_mask, uint16_t presses = 0);
+
+    // Eventos de tecla (aplicados antes de cada quadro na reprodução)
+    const InputScript& get_input() const { return input; }
+
+    // Grava/lê o filme em arquivo; retorna false (com mensagem) se houver erro
+    bool save_file(const std::string& path) const;
+    bool load_file(const std::string& path);
+
+private:
+    InputScript input;
+    uint16_t last_mask = 0;
+};
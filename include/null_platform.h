@@ -0,0 +1,33 @@
+// Plataforma nula do Chip-8 (modo headless)
+// Sem janela, sem áudio e sem teclado: para CI, testes de corpus e medições
+
+#pragma once
+#include "platform.h"
+
+class NullAudio : public Audio {
+public:
+    void queue_samples(const int16_t*, size_t) override {}
+    bool is_enabled() const override { return false; }
+};
+
+class NullPlatform : public Platform {
+public:
+    NullPlatform();
+    ~NullPlatform() override;
+
+    // Nunca há eventos; a execução termina pelos limites de quadros ou ciclos
+    bool poll_events(Input& input) override;
+
+    // Nunca há eventos: retorna sem esperar
+    bool wait_events(Input& input, int timeout_ms) override;
+
+    // Só consome o flag de mudança do framebuffer
+    void present(Display& display) override;
+
+    Audio& audio() override { return null_audio; }
+
+    int refresh_rate() const override { return 0; }
+
+private:
+    NullAudio null_audio;
+};
@@ -0,0 +1,157 @@
+// Tabela de opcodes do Chip-8 gerada em tempo de compilação
+// Classifica cada um dos 65536 opcodes possíveis em uma operação (Op)
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <cstddef>
+
+// Lista de operações: X(nome, mnemônico)
+#define CHIP8_OPCODES(X)              \
+    X(CLS,       "CLS")               \
+    X(RET,       "RET")               \
+    X(JP,        "JP addr")           \
+    X(CALL,      "CALL addr")         \
+    X(SE_BYTE,   "SE Vx, byte")       \
+    X(SNE_BYTE,  "SNE Vx, byte")      \
+    X(SE_REG,    "SE Vx, Vy")         \
+    X(LD_BYTE,   "LD Vx, byte")       \
+    X(ADD_BYTE,  "ADD Vx, byte")      \
+    X(LD_REG,    "LD Vx, Vy")         \
+    X(OR,        "OR Vx, Vy")         \
+    X(AND,       "AND Vx, Vy")        \
+    X(XOR,       "XOR Vx, Vy")        \
+    X(ADD_REG,   "ADD Vx, Vy")        \
+    X(SUB,       "SUB Vx, Vy")        \
+    X(SHR,       "SHR Vx")            \
+    X(SUBN,      "SUBN Vx, Vy")       \
+    X(SHL,       "SHL Vx")            \
+    X(SNE_REG,   "SNE Vx, Vy")        \
+    X(LD_I,      "LD I, addr")        \
+    X(JP_V0,     "JP V0, addr")       \
+    X(RND,       "RND Vx, byte")      \
+    X(DRW,       "DRW Vx, Vy, n")     \
+    X(SKP,       "SKP Vx")            \
+    X(SKNP,      "SKNP Vx")           \
+    X(LD_VX_DT,  "LD Vx, DT")         \
+    X(LD_VX_K,   "LD Vx, K")          \
+    X(LD_DT_VX,  "LD DT, Vx")         \
+    X(LD_ST_VX,  "LD ST, Vx")         \
+    X(ADD_I,     "ADD I, Vx")         \
+    X(LD_F,      "LD F, Vx")          \
+    X(LD_B,      "LD B, Vx")          \
+    X(LD_MEM_VX, "LD [I], Vx")        \
+    X(LD_VX_MEM, "LD Vx, [I]")        \
+    X(UNKNOWN,   "???")
+
+enum class Op : uint8_t {
+#define CHIP8_OP_ENUM(name, mnemonic) name,
+    CHIP8_OPCODES(CHIP8_OP_ENUM)
+#undef CHIP8_OP_ENUM
+    COUNT
+};
+
+constexpr size_t OP_COUNT = static_cast<size_t>(Op::COUNT);
+
+// Mnemônicos indexados por Op
+constexpr const char* OP_NAMES[OP_COUNT] = {
+#define CHIP8_OP_NAME(name, mnemonic) mnemonic,
+    CHIP8_OPCODES(CHIP8_OP_NAME)
+#undef CHIP8_OP_NAME
+};
+
+// Classifica um opcode (mesmas regras da antiga árvore de switches)
+constexpr Op classify_opcode(uint16_t opcode) {
+    switch (opcode & 0xF000) {
+        case 0x0000:
+            if (opcode == 0x00E0) return Op::CLS;
+            if (opcode == 0x00EE) return Op::RET;
+            return Op::UNKNOWN;
+        case 0x1000: return Op::JP;
+        case 0x2000: return Op::CALL;
+        case 0x3000: return Op::SE_BYTE;
+        case 0x4000: return Op::SNE_BYTE;
+        case 0x5000: return Op::SE_REG;
+        case 0x6000: return Op::LD_BYTE;
+        case 0x7000: return Op::ADD_BYTE;
+        case 0x8000:
+            switch (opcode & 0x000F) {
+                case 0x0: return Op::LD_REG;
+                case 0x1: return Op::OR;
+                case 0x2: return Op::AND;
+                case 0x3: return Op::XOR;
+                case 0x4: return Op::ADD_REG;
+                case 0x5: return Op::SUB;
+                case 0x6: return Op::SHR;
+                case 0x7: return Op::SUBN;
+                case 0xE: return Op::SHL;
+                default: return Op::UNKNOWN;
+            }
+        case 0x9000: return Op::SNE_REG;
+        case 0xA000: return Op::LD_I;
+        case 0xB000: return Op::JP_V0;
+        case 0xC000: return Op::RND;
+        case 0xD000: return Op::DRW;
+        case 0xE000:
+            if ((opcode & 0x00FF) == 0x9E) return Op::SKP;
+            if ((opcode & 0x00FF) == 0xA1) return Op::SKNP;
+            return Op::UNKNOWN;
+        default: // 0xF000
+            switch (opcode & 0x00FF) {
+                case 0x07: return Op::LD_VX_DT;
+                case 0x0A: return Op::LD_VX_K;
+                case 0x15: return Op::LD_DT_VX;
+                case 0x18: return Op::LD_ST_VX;
+                case 0x1E: return Op::ADD_I;
+                case 0x29: return Op::LD_F;
+                case 0x33: return Op::LD_B;
+                case 0x55: return Op::LD_MEM_VX;
+                case 0x65: return Op::LD_VX_MEM;
+                default: return Op::UNKNOWN;
+            }
+    }
+}
+
+// Gera a tabela completa opcode -> Op
+constexpr std::array<Op, 0x10000> make_opcode_table() {
+    std::array<Op, 0x10000> table{};
+    for (uint32_t opcode = 0; opcode < 0x10000; ++opcode) {
+        table[opcode] = classify_opcode(static_cast<uint16_t>(opcode));
+    }
+    return table;
+}
+
+inline constexpr std::array<Op, 0x10000> OPCODE_TABLE = make_opcode_table();
+
+// Fusões de instruções (superinstruções do interpretador): X(nome, sequência, primeira operação)
+#define CHIP8_FUSIONS(X)                                   \
+    X(LD_I_DRW,     "ANNN; DXYN",       LD_I)              \
+    X(LD_I_LOAD,    "ANNN; FX65",       LD_I)              \
+    X(LD_I_STORE,   "ANNN; FX55",       LD_I)              \
+    X(LD_DT_BYTE,   "6XKK; FX15",       LD_BYTE)           \
+    X(BCD_LOAD,     "FX33; FX65",       LD_B)              \
+    X(COUNTED_LOOP, "7XKK; 3XKK; 1NNN", ADD_BYTE)
+
+enum class Fusion : uint8_t {
+#define CHIP8_FUSION_ENUM(name, sequence, first) name,
+    CHIP8_FUSIONS(CHIP8_FUSION_ENUM)
+#undef CHIP8_FUSION_ENUM
+    COUNT,
+    NONE = COUNT
+};
+
+constexpr size_t FUSION_COUNT = static_cast<size_t>(Fusion::COUNT);
+
+// Sequências indexadas por Fusion
+constexpr const char* FUSION_NAMES[FUSION_COUNT] = {
+#define CHIP8_FUSION_NAME(name, sequence, first) sequence,
+    CHIP8_FUSIONS(CHIP8_FUSION_NAME)
+#undef CHIP8_FUSION_NAME
+};
+
+// Despacho por computed goto (threaded code) quando o compilador suporta
+#if defined(__GNUC__) || defined(__clang__)
+#define CHIP8_THREADED_DISPATCH 1
+#else
+#define CHIP8_THREADED_DISPATCH 0
+#endif
@@ -0,0 +1,43 @@
+// Plataforma do emulador Chip-8
+// Interface entre o núcleo (CPU, memória, framebuffer) e o host: janela, áudio e teclado
+
+#pragma once
+#include "display.h"
+#include "input.h"
+#include "audio.h"
+
+// Comandos do usuário para o emulador (teclas de atalho)
+enum class HostCommand {
+    SaveState,  // Salva o estado no slot rápido
+    LoadState   // Restaura o slot rápido
+};
+
+class Platform {
+public:
+    virtual ~Platform() = default;
+
+    // Processa os eventos pendentes do host; retorna false se o usuário pediu para sair
+    virtual bool poll_events(Input& input) = 0;
+
+    // Retira o próximo comando pendente (coletado em poll_events); false se não há
+    virtual bool next_command(HostCommand& command) {
+        (void)command;
+        return false;
+    }
+
+    // Indica se a tecla de rebobinar está pressionada
+    virtual bool rewind_held() const { return false; }
+
+    // Dorme até o host entregar um evento (ou até timeout_ms) e processa os pendentes como
+    // poll_events; retorna false se o usuário pediu para sair
+    virtual bool wait_events(Input& input, int timeout_ms) = 0;
+
+    // Apresenta o framebuffer, se ele mudou desde a última apresentação
+    virtual void present(Display& display) = 0;
+
+    // Saída de áudio da plataforma
+    virtual Audio& audio() = 0;
+
+    // Taxa de atualização do monitor em Hz (0 se desconhecida)
+    virtual int refresh_rate() const = 0;
+};
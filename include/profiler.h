@@ -0,0 +1,97 @@
+// Profiler de execução do Chip-8
+// Contadores por PC, por operação, por sub-rotina (via 2NNN/00EE) e mapas de leitura/escrita da RAM
+//
+// Os contadores são incrementos em arrays fixos feitos pelo próprio laço do interpretador
+// (instanciado com profiling), baratos o bastante para ficar ligados em execuções longas.
+// As sub-rotinas formam uma árvore de chamadas: cada nó é um caminho main;sub_0x2A4;...
+// e acumula as instruções executadas enquanto é o topo da pilha.
+//
+// Saídas: JSON com todos os contadores e um arquivo de pilhas "folded"
+// ("main;sub_0x2a4;sub_0x310 1234" por linha), aceito por flamegraph.pl e speedscope.
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "config.h"
+#include "opcodes.h"
+
+class Profiler {
+public:
+    static constexpr size_t MAX_NODES = 1 << 16;   // Caminhos de chamada distintos guardados
+
+    Profiler();
+
+    // Conta uma instrução prestes a executar em pc (I e SP antes da execução)
+    void record(uint16_t pc, uint16_t opcode, Op op, uint16_t i, uint8_t sp) {
+        ++pc_hits[pc & ADDRESS_MASK];
+        ++op_counts[static_cast<size_t>(op)];
+        ++family_counts[opcode >> 12];
+        ++nodes[current].self;
+        switch (op) {
+            case Op::DRW: add_range(reads, i, opcode & 0xF); break;
+            case Op::LD_VX_MEM: add_range(reads, i, ((opcode >> 8) & 0xF) + 1); break;
+            case Op::LD_MEM_VX: add_range(writes, i, ((opcode >> 8) & 0xF) + 1); break;
+            case Op::LD_B: add_range(writes, i, 3); break;
+            case Op::CALL: if (sp < Config::CPU::STACK_SIZE) enter(opcode & 0xFFF); break;
+            case Op::RET: if (sp > 0) leave(); break;
+            default: break;
+        }
+    }
+
+    // Instruções de um laço ocioso contadas sem executar (loop = início do laço)
+    void record_idle(uint16_t loop, int skipped) {
+        idle_hits[loop & ADDRESS_MASK] += static_cast<uint64_t>(skipped);
+        nodes[current].self += static_cast<uint64_t>(skipped);
+    }
+
+    // Volta a pilha de chamadas para main (ex.: após restaurar um estado)
+    void reset_stack() { current = 0; }
+
+    // Total de instruções contadas (executadas + puladas em laços ociosos)
+    uint64_t total_instructions() const;
+
+    // Grava os contadores em JSON; retorna false (com mensagem) se houver erro
+    bool save_json(const std::string& path, const std::string& rom) const;
+
+    // Grava as pilhas no formato folded
+    bool save_folded(const std::string& path) const;
+
+private:
+    static constexpr uint16_t ADDRESS_MASK = Config::Memory::SIZE - 1;
+
+    struct Node {
+        uint32_t parent;
+        uint16_t function;   // Endereço da sub-rotina (0 no nó raiz, main)
+        uint64_t calls;
+        uint64_t self;       // Instruções com este caminho no topo
+    };
+
+    std::array<uint64_t, Config::Memory::SIZE> pc_hits{};
+    std::array<uint64_t, Config::Memory::SIZE> idle_hits{};
+    std::array<uint64_t, Config::Memory::SIZE> reads{};
+    std::array<uint64_t, Config::Memory::SIZE> writes{};
+    std::array<uint64_t, OP_COUNT> op_counts{};
+    std::array<uint64_t, 16> family_counts{};     // Pelo primeiro nibble (0NNN ... FXNN)
+
+    std::vector<Node> nodes;
+    std::unordered_map<uint64_t, uint32_t> children;   // (pai << 16 | função) -> nó
+    uint32_t current = 0;
+
+    static void add_range(std::array<uint64_t, Config::Memory::SIZE>& map, uint16_t start, unsigned count) {
+        for (unsigned k = 0; k < count; ++k) ++map[(start + k) & ADDRESS_MASK];
+    }
+
+    // 2NNN: desce para o nó filho (criado na primeira chamada)
+    void enter(uint16_t function);
+
+    // 00EE: volta ao nó pai
+    void leave() {
+        if (current != 0) current = nodes[current].parent;
+    }
+
+    // Caminho do nó no formato folded (main;sub_0x...)
+    std::string path(uint32_t node) const;
+};
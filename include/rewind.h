@@ -0,0 +1,72 @@
+// Rebobinar (rewind) do Chip-8
+// Anel de tamanho fixo com os últimos quadros, cada um guardado como delta XOR/RLE do seguinte
+//
+// Guarda o estado mais recente completo (head) e, para cada quadro anterior, o XOR entre ele e
+// o quadro seguinte, codificado em palavras de 64 bits: [u16 palavras zeradas][u16 palavras
+// literais][literais...]. Voltar um quadro é aplicar o XOR do delta mais novo em head.
+// Sem espaço, os deltas mais antigos são descartados.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "snapshot.h"
+
+class Rewind {
+public:
+    // buffer_bytes: memória do anel de deltas; max_frames: quadros guardados no máximo
+    Rewind(size_t buffer_bytes, size_t max_frames);
+
+    // Registra o estado do quadro atual
+    void capture(const Snapshot& state);
+
+    // Volta um quadro: escreve em state o estado anterior; false se não há histórico
+    bool step_back(Snapshot& state);
+
+    // Descarta todo o histórico
+    void clear();
+
+    // Quadros que podem ser rebobinados
+    size_t frames() const { return count; }
+
+    // Bytes ocupados pelos deltas e capacidade total (anel + estado completo)
+    size_t bytes_used() const { return used; }
+    size_t capacity() const { return buffer.size() + sizeof(Snapshot); }
+
+    // Tempo médio de captura em microssegundos
+    double average_capture_us() const { return captures ? capture_ns / 1000.0 / captures : 0.0; }
+
+private:
+    struct Entry {
+        size_t offset;
+        size_t size;
+    };
+
+    static constexpr size_t WORDS = sizeof(Snapshot) / sizeof(uint64_t);
+    static_assert(sizeof(Snapshot) % sizeof(uint64_t) == 0, "Snapshot precisa ter tamanho múltiplo de 8");
+
+    std::vector<uint8_t> buffer;  // Anel de bytes com os deltas
+    std::vector<Entry> entries;   // Anel de deltas, do mais antigo (first) ao mais novo
+    size_t first = 0;
+    size_t count = 0;
+    size_t write_pos = 0;
+    size_t used = 0;
+
+    Snapshot head;                // Estado completo do quadro mais recente
+    bool has_head = false;
+    std::vector<uint8_t> scratch; // Delta em construção
+
+    uint64_t capture_ns = 0;
+    uint64_t captures = 0;
+
+    // Codifica head XOR state em scratch; retorna o tamanho
+    size_t encode(const Snapshot& state);
+
+    // Aplica um delta em head
+    void apply(const uint8_t* delta, size_t size);
+
+    // Reserva size bytes no anel, descartando os deltas mais antigos que ocupam o espaço
+    size_t allocate(size_t size);
+
+    void drop_oldest();
+};
@@ -0,0 +1,32 @@
+// Gerador pseudoaleatório do Chip-8
+// xorshift32 por instância: rápido, sem estado global e reprodutível a partir da semente
+// O estado fica em CpuState::rng_state; o Rng é só uma visão sobre ele
+
+#pragma once
+#include <cstdint>
+
+class Rng {
+public:
+    explicit Rng(uint32_t& state) : state(state) {}
+
+    // Reinicia a sequência (a semente 0 é trocada, pois zera o xorshift)
+    void set_seed(uint32_t seed) { state = seed ? seed : 0x9E3779B9u; }
+
+    // Próximo valor de 32 bits
+    uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // Estado interno (snapshots)
+    uint32_t get_state() const { return state; }
+    void set_state(uint32_t value) { state = value ? value : 0x9E3779B9u; }
+
+    // Próximo byte (bits altos, os de melhor qualidade)
+    uint8_t next_byte() { return static_cast<uint8_t>(next() >> 24); }
+
+private:
+    uint32_t& state;
+};
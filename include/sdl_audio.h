@@ -0,0 +1,19 @@
+// Áudio do Chip-8 via SDL2
+// Enfileira no dispositivo as amostras geradas a cada quadro emulado (SDL_QueueAudio)
+
+#pragma once
+#include <SDL2/SDL.h>
+#include "audio.h"
+
+class SdlAudio : public Audio {
+public:
+    SdlAudio();
+    ~SdlAudio() override;
+
+    // Enfileira as amostras do quadro; descarta se a fila já passou do limite
+    void queue_samples(const int16_t* samples, size_t count) override;
+
+private:
+    SDL_AudioDeviceID device;
+    Uint32 max_queued_bytes;   // Latência máxima da fila (MAX_QUEUED_FRAMES quadros)
+};
@@ -0,0 +1,58 @@
+// Plataforma SDL2 do Chip-8
+// Janela, renderer, áudio e teclado físico via SDL2
+
+#pragma once
+#include <SDL2/SDL.h>
+#include <memory>
+#include <vector>
+#include "config.h"
+#include "platform.h"
+#include "sdl_audio.h"
+
+class SdlPlatform : public Platform {
+public:
+    // Inicializa SDL, cria a janela e abre o dispositivo de áudio
+    explicit SdlPlatform(int scale = Config::Display::DEFAULT_SCALE);
+    ~SdlPlatform() override;
+
+    SdlPlatform(const SdlPlatform&) = delete;
+    SdlPlatform& operator=(const SdlPlatform&) = delete;
+
+    // Processa eventos SDL; retorna false em SDL_QUIT ou ESC
+    bool poll_events(Input& input) override;
+
+    // Teclas de atalho: F5 salva o estado, F9 restaura
+    bool next_command(HostCommand& command) override;
+
+    // Backspace pressionado rebobina
+    bool rewind_held() const override { return rewind_key_down; }
+
+    // Dorme em SDL_WaitEventTimeout até chegar um evento; false em SDL_QUIT ou ESC
+    bool wait_events(Input& input, int timeout_ms) override;
+
+    // Envia o framebuffer para a janela, somente se houve mudança ou se a janela pediu redesenho
+    void present(Display& display) override;
+
+    Audio& audio() override { return *sdl_audio; }
+
+    int refresh_rate() const override;
+
+private:
+    SDL_Window* window;
+    SDL_Renderer* renderer;
+    SDL_Texture* texture;
+    std::unique_ptr<SdlAudio> sdl_audio;
+    std::vector<HostCommand> commands; // Atalhos ainda não retirados
+    bool rewind_key_down;
+    bool redraw_pending;  // Janela exposta: apresentar de novo a textura atual
+    bool upload_pending;  // Janela redimensionada/restaurada ou textura perdida: reenviar todas as linhas
+
+    // Converte a tecla pressionada para o índice correspondente no teclado do Chip-8
+    static int map_key(SDL_Keycode key);
+
+    // Desenha a textura na janela inteira e apresenta
+    void render();
+
+    // Atualiza o teclado (e os pedidos de redesenho da janela) com um evento; retorna false se o evento pede para sair
+    bool handle_event(const SDL_Event& e, Input& input);
+};
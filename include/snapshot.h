@@ -0,0 +1,52 @@
+// Estado completo da máquina Chip-8 (save states)
+// Cópia em memória restaurável com poucos memcpys e formato binário compacto e versionado
+//
+// Formato do arquivo (little-endian, 4432 bytes na versão 2; a versão 1 não tem o bloco
+// final de 8 bytes e ainda é aceita, sem espera de FX0A):
+//     0  "CH8S"            magic
+//     4  u16 versão        Snapshot::VERSION
+//     6  u16 reservado     0
+//     8  V0-VF             16 bytes
+//    24  u16 I, u16 PC
+//    28  u8 SP, u8 DT, u8 ST, u8 reservado
+//    32  pilha             16 x u16
+//    64  u32 estado do gerador pseudoaleatório
+//    68  u16 teclas        bit k = tecla k pressionada
+//    70  u16 reservado
+//    72  framebuffer       32 x u64 (bit 63 = coluna 0)
+//   328  RAM               4096 bytes
+//  4424  u8 espera FX0A    registrador de destino + 1 (0 = sem espera)
+//  4425  u8 reservado
+//  4426  u16 teclas        seguradas ao entrar na espera
+//  4428  u16 teclas        pressionadas durante a espera
+//  4430  u16 reservado
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <string>
+#include <vector>
+#include "cpu.h"
+#include "memory.h"
+#include "display.h"
+
+struct Snapshot {
+    static constexpr uint16_t VERSION = 2;
+    static constexpr size_t SERIALIZED_SIZE_V1 = 328 + Memory::MEMORY_SIZE;
+    static constexpr size_t SERIALIZED_SIZE = SERIALIZED_SIZE_V1 + 8;
+
+    CpuState cpu;
+    std::array<uint64_t, Display::HEIGHT> rows;
+    std::array<uint8_t, Memory::MEMORY_SIZE> ram;
+    uint16_t keys;
+
+    // Gera o blob binário versionado
+    std::vector<uint8_t> serialize() const;
+
+    // Lê um blob; retorna false (com mensagem) se o formato ou a versão não conferem
+    bool deserialize(const std::vector<uint8_t>& blob);
+
+    // Grava/lê o blob em arquivo
+    bool save_file(const std::string& path) const;
+    bool load_file(const std::string& path);
+};
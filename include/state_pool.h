@@ -0,0 +1,41 @@
+// Pool de MachineState para busca em árvore (MCTS, beam search)
+// Os estados vêm de blocos alocados de uma vez e voltam para uma lista livre: depois do
+// aquecimento, clonar e liberar nós não aloca nada
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "machine_state.h"
+
+class StatePool {
+public:
+    // Reserva initial estados; esgotado, o pool cresce em blocos de CHUNK_STATES
+    explicit StatePool(size_t initial = CHUNK_STATES);
+
+    StatePool(const StatePool&) = delete;
+    StatePool& operator=(const StatePool&) = delete;
+
+    // Retira um estado (conteúdo indefinido)
+    MachineState* acquire();
+
+    // Retira um estado com uma cópia de source
+    MachineState* clone(const MachineState& source);
+
+    // Devolve um estado retirado deste pool
+    void release(MachineState* state) { free_list.push_back(state); }
+
+    // Estados alocados e estados livres
+    size_t capacity() const { return total; }
+    size_t available() const { return free_list.size(); }
+
+private:
+    static constexpr size_t CHUNK_STATES = 1024;
+
+    std::vector<std::unique_ptr<MachineState[]>> chunks;
+    std::vector<MachineState*> free_list;
+    size_t total = 0;
+
+    // Aloca mais count estados e os põe na lista livre
+    void grow(size_t count);
+};
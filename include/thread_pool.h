@@ -0,0 +1,57 @@
+// Pool de threads com roubo de trabalho
+// Cada thread tem sua fila; sem trabalho próprio, rouba do início da fila das outras
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    // threads = 0 usa todos os núcleos do host
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Enfileira uma tarefa (de dentro de uma tarefa, vai para a fila da própria thread)
+    void submit(std::function<void()> task);
+
+    // Bloqueia até que todas as tarefas enviadas terminem
+    void wait();
+
+    // Número de threads do pool
+    unsigned size() const { return thread_count; }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // Fixo antes de a primeira thread começar: as threads o leem enquanto workers ainda cresce
+    const unsigned thread_count;
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;                  // Protege o sono das threads e o fim das tarefas
+    std::condition_variable work_cv;   // Há tarefas na fila (ou o pool está parando)
+    std::condition_variable done_cv;   // Todas as tarefas terminaram
+    std::atomic<size_t> queued{0};     // Tarefas nas filas
+    std::atomic<size_t> pending{0};    // Tarefas nas filas ou em execução
+    std::atomic<unsigned> next_queue{0};
+    bool stopping = false;
+
+    // Retira uma tarefa: do fim da própria fila ou do início das outras
+    bool try_pop(unsigned index, std::function<void()>& task);
+
+    // Laço de cada thread
+    void worker_loop(unsigned index);
+};
@@ -0,0 +1,186 @@
+// Trace assíncrono do Chip-8
+// Eventos binários (PC, opcode, tipo) em anéis SPSC sem trava, um por CPU, drenados por uma thread
+//
+// O caminho quente só copia 8 bytes para o anel da CPU. A thread de drenagem formata os
+// diagnósticos para std::cerr (no máximo Config::Trace::MESSAGES_PER_SECOND por tipo a cada
+// segundo) e, se houver arquivo aberto, grava todos os eventos nele, inclusive o trace de execução.
+//
+// Formato do arquivo (little-endian; lido por chip8-trace):
+//     0  "CH8T"          magic
+//     4  u16 versão      Tracer::VERSION
+//     6  u16 reservado   0
+//     8  eventos         8 bytes cada: u16 PC, u16 opcode, u8 tipo, u8 argumento, u16 origem
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "config.h"
+
+// Tipos de evento: X(nome, rótulo)
+#define CHIP8_TRACE_KINDS(X)               \
+    X(Exec,           "exec")              \
+    X(UnknownOpcode,  "opcode-desconhecido") \
+    X(StackOverflow,  "stack-overflow")    \
+    X(StackUnderflow, "stack-underflow")   \
+    X(InvalidKey,     "tecla-invalida")    \
+    X(FontWrite,      "escrita-sprites")
+
+enum class TraceKind : uint8_t {
+#define CHIP8_TRACE_ENUM(name, label) name,
+    CHIP8_TRACE_KINDS(CHIP8_TRACE_ENUM)
+#undef CHIP8_TRACE_ENUM
+    COUNT
+};
+
+constexpr size_t TRACE_KIND_COUNT = static_cast<size_t>(TraceKind::COUNT);
+
+// Rótulos indexados por TraceKind
+constexpr const char* TRACE_KIND_NAMES[TRACE_KIND_COUNT] = {
+#define CHIP8_TRACE_NAME(name, label) label,
+    CHIP8_TRACE_KINDS(CHIP8_TRACE_NAME)
+#undef CHIP8_TRACE_NAME
+};
+
+struct TraceEvent {
+    uint16_t pc;        // Endereço da instrução
+    uint16_t opcode;
+    TraceKind kind;
+    uint8_t arg;        // Tecla (InvalidKey) ou byte baixo do endereço (FontWrite)
+    uint16_t source;    // Anel de origem (uma CPU)
+};
+static_assert(sizeof(TraceEvent) == 8, "TraceEvent deve ocupar 8 bytes");
+
+// Fila circular de produtor único e consumidor único, sem travas
+template <typename T, size_t N>
+class SpscRing {
+    static_assert((N & (N - 1)) == 0, "A capacidade precisa ser potência de 2");
+
+public:
+    // Produtor: retorna false se a fila está cheia
+    bool push(const T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - cached_tail >= N) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (h - cached_tail >= N) return false;
+        }
+        items[h & (N - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor: copia até max itens para out; retorna quantos
+    size_t pop(T* out, size_t max) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t available = head.load(std::memory_order_acquire) - t;
+        size_t count = available < max ? available : max;
+        for (size_t i = 0; i < count; ++i) out[i] = items[(t + i) & (N - 1)];
+        tail.store(t + count, std::memory_order_release);
+        return count;
+    }
+
+private:
+    alignas(64) std::atomic<size_t> head{0};   // Escrito só pelo produtor
+    size_t cached_tail = 0;                    // Última cauda vista pelo produtor
+    alignas(64) std::atomic<size_t> tail{0};   // Escrito só pelo consumidor
+    alignas(64) std::array<T, N> items;
+};
+
+// Anel de eventos de uma CPU; o produtor é a thread que executa a CPU
+class TraceRing {
+public:
+    // pc e ram são lidos no momento do evento para localizar a instrução em execução
+    TraceRing(const uint16_t& pc, const uint8_t* ram);
+    ~TraceRing();
+
+    TraceRing(const TraceRing&) = delete;
+    TraceRing& operator=(const TraceRing&) = delete;
+
+    // Diagnóstico da instrução em execução; descartado (e contado) se o anel estiver cheio
+    void emit(TraceKind kind, uint8_t arg = 0);
+
+    // Trace de execução: espera a drenagem se o anel estiver cheio, nada se perde
+    void emit_exec(uint16_t pc, uint16_t opcode);
+
+    // Diagnóstico para o anel da CPU em execução nesta thread (nada fora de CPU::run)
+    static void emit_current(TraceKind kind, uint8_t arg = 0) {
+        if (current) current->emit(kind, arg);
+    }
+
+    // Torna este o anel da thread enquanto existir (CPU::run)
+    class Scope {
+    public:
+        explicit Scope(TraceRing& ring) : previous(current) { current = &ring; }
+        ~Scope() { current = previous; }
+
+    private:
+        TraceRing* previous;
+    };
+
+private:
+    friend class Tracer;
+
+    SpscRing<TraceEvent, Config::Trace::RING_EVENTS> ring;
+    const uint16_t& pc;
+    const uint8_t* ram;
+    uint16_t source = 0;
+    bool attached = false;                   // Registrado no Tracer (só o produtor altera)
+    std::atomic<uint64_t> dropped{0};        // Diagnósticos perdidos com o anel cheio
+
+    static thread_local TraceRing* current;
+
+    void push(const TraceEvent& event);
+};
+
+// Drenagem dos anéis: uma thread de fundo por processo, iniciada no primeiro evento
+class Tracer {
+public:
+    static constexpr uint16_t VERSION = 1;
+
+    static Tracer& instance();
+    ~Tracer();
+
+    // Passa a gravar todos os eventos em path; retorna false (com mensagem) se não abrir
+    bool open_file(const std::string& path);
+
+    // Drena o que houver e fecha o arquivo
+    void close_file();
+
+private:
+    friend class TraceRing;
+
+    Tracer() = default;
+
+    std::mutex mutex;                        // Protege tudo abaixo; a drenagem roda com ele travado
+    std::condition_variable wake;
+    std::thread drainer;
+    bool stopping = false;
+    std::vector<TraceRing*> rings;
+    uint16_t next_source = 0;
+    std::ofstream file;
+
+    // Limite de mensagens: janela de um segundo por tipo
+    std::chrono::steady_clock::time_point window_start;
+    std::array<int, TRACE_KIND_COUNT> shown{};
+    std::array<uint64_t, TRACE_KIND_COUNT> suppressed{};
+    uint64_t dropped = 0;                    // Eventos perdidos nos anéis já removidos
+
+    void attach(TraceRing& ring);
+    void detach(TraceRing& ring);
+
+    // Acorda a thread de drenagem (anel cheio no trace de execução)
+    void notify() { wake.notify_one(); }
+
+    void drain_loop();
+    void drain(TraceRing& ring);
+    void report(const TraceEvent& event);
+    void flush_suppressed();
+};
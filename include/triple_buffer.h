@@ -0,0 +1,41 @@
+// Buffer triplo sem trava (um escritor, um leitor)
+// O escritor monta o próximo valor em back() e publica; o leitor pega sempre o mais
+// recente em front(). Nenhum dos dois espera o outro: quadros intermediários são descartados
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+template <typename T>
+class TripleBuffer {
+public:
+    // Escritor: slot livre para montar o próximo valor
+    T& back() { return slots[back_index]; }
+
+    // Escritor: publica back() e passa a escrever no slot que estava no meio
+    void publish() {
+        uint8_t previous = middle.exchange(static_cast<uint8_t>(back_index | FRESH), std::memory_order_acq_rel);
+        back_index = previous & INDEX_MASK;
+    }
+
+    // Leitor: traz o valor publicado mais recente para front(); false se não há nada novo
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        uint8_t previous = middle.exchange(front_index, std::memory_order_acq_rel);
+        front_index = previous & INDEX_MASK;
+        return true;
+    }
+
+    // Leitor: último valor obtido por update()
+    const T& front() const { return slots[front_index]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 3;   // Índice do slot (0-2)
+    static constexpr uint8_t FRESH = 4;        // Slot do meio ainda não lido
+
+    std::array<T, 3> slots{};
+    alignas(64) std::atomic<uint8_t> middle{1};  // Slot trocado entre escritor e leitor
+    alignas(64) uint8_t back_index = 0;          // Só o escritor
+    alignas(64) uint8_t front_index = 2;         // Só o leitor
+};
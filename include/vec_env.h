@@ -0,0 +1,93 @@
+// Ambiente vetorizado: N instâncias headless da mesma ROM avançadas em lote
+// Um executor Chip8 por thread percorre os MachineState das instâncias (restaurar um estado da
+// mesma ROM não invalida o código decodificado, ver Chip8::load_state). O que é exposto por
+// instância fica em arrays contíguos (estrutura de arrays), com endereço fixo enquanto o
+// ambiente existir: quem chama mapeia os buffers uma vez (ex.: numpy via ctypes) e lê sem cópia.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "chip8.h"
+#include "config.h"
+#include "machine_state.h"
+#include "null_platform.h"
+#include "thread_pool.h"
+
+struct VecEnvOptions {
+    int ipf = 0;                                           // Instruções por quadro (0 = clock padrão)
+    CpuBackend backend = CpuBackend::Interpreter;          // Motor da CPU dos executores
+    unsigned threads = 1;                                  // Executores em paralelo (0 = todos os núcleos)
+    uint16_t load_address = Config::Memory::PROGRAM_START; // Endereço de carga da ROM
+    uint32_t seed = 1;                                     // Instância i usa seed + i
+};
+
+class VecEnv {
+public:
+    // Bytes do framebuffer de uma instância: 32 linhas de 8 bytes, bit 7 do byte 0 = coluna 0
+    static constexpr size_t FRAME_BYTES = Display::HEIGHT * Display::WIDTH / 8;
+
+    // Cria count instâncias da ROM já no estado inicial; lança std::invalid_argument se count
+    // não for positivo ou se a ROM não couber na memória
+    VecEnv(const std::vector<uint8_t>& rom, int count, const VecEnvOptions& options);
+    ~VecEnv();
+
+    VecEnv(const VecEnv&) = delete;
+    VecEnv& operator=(const VecEnv&) = delete;
+
+    // Número de instâncias
+    int size() const { return count; }
+
+    // Volta todas as instâncias ao estado inicial; seeds = nullptr usa options.seed + i
+    void reset(const uint32_t* seeds = nullptr);
+
+    // Volta uma instância ao estado inicial com a semente dada
+    void reset_one(int index, uint32_t seed);
+
+    // Avança todas as instâncias frames quadros, cada uma com as teclas keys[i] seguradas
+    // (bit k = tecla k; keys = nullptr solta todas). Um toque para o FX0A é um passo com a
+    // tecla pressionada seguido de um passo com ela solta
+    void step(const uint16_t* keys, int frames);
+
+    // count x FRAME_BYTES bytes, atualizados a cada reset/step
+    const uint8_t* framebuffers() const { return pixels.data(); }
+
+    // count bytes: 1 se o sound timer está ativo ao fim do último passo (o beep soa)
+    const uint8_t* sound() const { return sound_flags.data(); }
+
+    // count bytes: 1 se a instância está parada em FX0A esperando uma tecla
+    const uint8_t* waiting() const { return waiting_flags.data(); }
+
+    // Estado completo de uma instância (ex.: RAM como observação, clonagem para busca)
+    const MachineState& state(int index) const { return states[index]; }
+
+    // Maior número de blocos do JIT marcados para o interpretador entre os executores (cada
+    // passo restaura as instâncias, o que não pode rebaixar blocos; ver Chip8::load_state)
+    int get_jit_interpreted_blocks() const;
+
+private:
+    struct Runner {
+        NullPlatform platform;
+        Chip8 chip8{false};
+    };
+
+    int count;
+    VecEnvOptions options;
+    std::vector<MachineState> states;   // Estado de cada instância
+    MachineState boot;                  // ROM carregada, antes da semente
+    std::vector<uint8_t> pixels;        // Framebuffers empacotados, instância após instância
+    std::vector<uint8_t> sound_flags;
+    std::vector<uint8_t> waiting_flags;
+    std::vector<std::unique_ptr<Runner>> runners;
+    std::unique_ptr<ThreadPool> pool;   // nullptr com um único executor
+
+    // Divide as instâncias em faixas contíguas, uma por executor, e roda fn(runner, i) em cada
+    template <typename Fn> void for_each_instance(Fn fn);
+
+    // Estado inicial da instância index com a semente dada, usando runner
+    void boot_instance(Runner& runner, int index, uint32_t seed);
+
+    // Copia o framebuffer e os flags da instância index para os arrays expostos
+    void publish(int index);
+};
@@ -0,0 +1,36 @@
+// Saída de áudio em arquivo WAV (PCM mono de 16 bits)
+// Grava exatamente as amostras dos quadros emulados, sem depender do relógio do host
+
+#pragma once
+#include "audio.h"
+#include <cstdio>
+#include <string>
+
+class WavAudio : public Audio {
+public:
+    // Abre o arquivo e escreve o cabeçalho (tamanhos corrigidos em close)
+    explicit WavAudio(const std::string& path);
+    ~WavAudio() override;
+
+    WavAudio(const WavAudio&) = delete;
+    WavAudio& operator=(const WavAudio&) = delete;
+
+    bool is_open() const { return file != nullptr; }
+
+    // Acrescenta as amostras ao arquivo
+    void queue_samples(const int16_t* samples, size_t count) override;
+
+    // Corrige os tamanhos do cabeçalho e fecha; retorna false se alguma escrita falhou
+    bool close();
+
+    // Amostras gravadas até agora
+    uint64_t samples_written() const { return samples; }
+
+private:
+    static constexpr uint32_t HEADER_SIZE = 44;
+
+    std::FILE* file;
+    std::string path;
+    uint64_t samples;
+    bool failed;
+};
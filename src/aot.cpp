@@ -0,0 +1,80 @@
+// Recompilação estática (AOT) do Chip-8: execução dos programas gerados pelo chip8-aot
+// Cada bloco só roda inteiro: se não couber no orçamento do quadro, se o PC não tiver bloco ou
+// se os bytes do bloco na RAM já não forem os da ROM, o interpretador avança uma instrução.
+// Laços ociosos e FX0A seguem as mesmas regras do interpretador.
+
+#include "../include/aot.h"
+#include <algorithm>
+#include <cstring>
+
+// Executa opcode no interpretador com o PC já avançado, como no laço do interpretador
+void AotContext::exec(uint16_t opcode, uint16_t next_pc) {
+    state.PC = next_pc;
+    cpu.execute_opcode(opcode);
+}
+
+// Registra um programa gerado
+AotRegistration::AotRegistration(const AotProgram& program) {
+    Aot::registry().push_back(&program);
+}
+
+// Programas ligados ao executável (construída no primeiro registro)
+std::vector<const AotProgram*>& Aot::registry() {
+    static std::vector<const AotProgram*> programs;
+    return programs;
+}
+
+// Programa registrado cuja ROM está carregada em ram
+const AotProgram* Aot::find_program(const std::array<uint8_t, Memory::MEMORY_SIZE>& ram) {
+    for (const AotProgram* program : registry()) {
+        if (program->load_address + program->image_size > Memory::MEMORY_SIZE) continue;
+        if (std::memcmp(ram.data() + program->load_address, program->image, program->image_size) == 0) return program;
+    }
+    return nullptr;
+}
+
+// Indexa os blocos do programa pelo PC inicial
+Aot::Aot(CPU& cpu, const AotProgram& program)
+    : cpu(cpu), program(program), context(cpu, cpu.state, cpu.memory.get_ram().data()) {
+    for (uint16_t b = 0; b < program.block_count; ++b) {
+        const AotBlock& block = program.blocks[b];
+        entries[block.pc].block = &block;
+    }
+}
+
+// Confere se o bloco da entrada pode rodar (só depois de escritas nos seus trechos)
+bool Aot::is_current(Entry& entry) {
+    const AotBlock& block = *entry.block;
+    uint32_t seen = generation[block.pc / CHUNK] + generation[(block.pc + block.bytes - 1) / CHUNK];
+    if (seen == entry.seen) return entry.valid;
+    entry.seen = seen;
+    entry.valid = std::memcmp(context.ram + block.pc, program.image + (block.pc - program.load_address), block.bytes) == 0;
+    // O corpo do laço pode estar fora do bloco: a marca é refeita a cada conferência, como no JIT
+    entry.idle_loop = entry.valid && block.jump && cpu.idle_skip &&
+                      cpu.is_idle_loop_candidate(block.jump, ((context.ram[block.jump] << 8) | context.ram[block.jump + 1]) & 0x0FFF);
+    return entry.valid;
+}
+
+// Executa até max_cycles instruções
+int Aot::run(int max_cycles) {
+    CpuState& regs = cpu.state;
+    int executed = 0;
+    while (executed < max_cycles) {
+        Entry* entry = regs.PC < Memory::MEMORY_SIZE ? &entries[regs.PC] : nullptr;
+        if (entry && entry->block && entry->block->instructions <= max_cycles - executed && is_current(*entry)) {
+            entry->block->run(context);
+            executed += entry->block->instructions;
+            if (entry->idle_loop) executed += cpu.skip_idle_loop(max_cycles - executed);
+        } else {
+            executed += cpu.run_interpreter<false>(1);
+        }
+        if (regs.key_wait_reg >= 0) return executed + cpu.idle_key_wait(max_cycles - executed);
+    }
+    return executed;
+}
+
+// Escrita na memória: os trechos tocados mudam de geração
+void Aot::invalidate(uint16_t address, uint16_t length) {
+    uint32_t last = std::min<uint32_t>(uint32_t(address) + length, Memory::MEMORY_SIZE);
+    for (uint32_t chunk = address / CHUNK; chunk * CHUNK < last; ++chunk) ++generation[chunk];
+}
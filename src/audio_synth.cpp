@@ -0,0 +1,79 @@
+// Sintetizador do beep do Chip-8
+// Tabela de onda pré-calculada + acumulador de fase: sem divisão nem módulo por amostra
+
+#include "../include/audio_synth.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int RATE = Config::Audio::SAMPLE_RATE;
+constexpr int FPS = Config::CPU::TIMER_FREQUENCY;
+constexpr int TABLE_BITS = __builtin_ctz(Config::Audio::WAVETABLE_SIZE);
+static_assert((Config::Audio::WAVETABLE_SIZE & (Config::Audio::WAVETABLE_SIZE - 1)) == 0,
+              "WAVETABLE_SIZE precisa ser potência de 2");
+
+// Incremento de fase por amostra: FREQUENCY / SAMPLE_RATE períodos em ponto fixo de 32 bits
+constexpr uint32_t PHASE_STEP =
+    static_cast<uint32_t>((static_cast<uint64_t>(Config::Audio::FREQUENCY) << 32) / RATE);
+
+// Amostras do quadro n: diferença entre as fronteiras de quadro arredondadas, para que
+// a soma acompanhe exatamente n * SAMPLE_RATE / 60 mesmo quando a divisão não é exata
+size_t samples_for_frame(uint64_t n) {
+    return static_cast<size_t>((n + 1) * RATE / FPS - n * RATE / FPS);
+}
+
+}
+
+AudioSynth::AudioSynth() {
+    buffer.resize(RATE / FPS + 1);
+}
+
+// Calculada uma vez por processo (inicialização de static local é thread-safe)
+const AudioSynth::Wavetable& AudioSynth::wavetable() {
+    static const Wavetable table = [] {
+        Wavetable t{};
+        const double pi = std::acos(-1.0);
+        const int harmonics = RATE / 2 / Config::Audio::FREQUENCY;
+        std::array<double, Config::Audio::WAVETABLE_SIZE> wave{};
+        double peak = 0;
+        for (size_t i = 0; i < wave.size(); ++i) {
+            double x = 2 * pi * i / wave.size();
+            for (int k = 1; k <= harmonics; k += 2) wave[i] += std::sin(k * x) / k;
+            peak = std::max(peak, std::fabs(wave[i]));
+        }
+        for (size_t i = 0; i < wave.size(); ++i) {
+            t[i] = static_cast<int16_t>(std::lround(wave[i] / peak * Config::Audio::AMPLITUDE));
+        }
+        return t;
+    }();
+    return table;
+}
+
+// Gera as amostras do próximo quadro
+size_t AudioSynth::render_frame(bool tone_on) {
+    const Wavetable& table = wavetable();
+    const size_t count = samples_for_frame(frame++);
+    const int target = tone_on ? Config::Audio::RAMP_SAMPLES : 0;
+
+    // Silêncio estável: sem tabela nem rampa (a fase para e o próximo beep começa do zero)
+    if (gain == 0 && target == 0) {
+        std::fill(buffer.begin(), buffer.begin() + count, int16_t(0));
+        phase = 0;
+        return count;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (gain != target) gain += gain < target ? 1 : -1;
+        int sample = table[phase >> (32 - TABLE_BITS)];
+        buffer[i] = static_cast<int16_t>(sample * gain / Config::Audio::RAMP_SAMPLES);
+        phase += PHASE_STEP;
+    }
+    return count;
+}
+
+// Volta ao início da linha do tempo
+void AudioSynth::reset() {
+    frame = 0;
+    phase = 0;
+    gain = 0;
+}
@@ -2,23 +2,25 @@
 // Integra todos os módulos e gerencia o ciclo de execução
 
 #include "../include/chip8.h"
+#include <algorithm>
 #include <iostream>
 
-// Construtor: inicializa ponteiros e flags
-Chip8::Chip8() : display(nullptr), cpu(nullptr), scale(Config::Display::DEFAULT_SCALE), clock_speed(Config::CPU::DEFAULT_CLOCK_SPEED), initialized(false) {}
+// Construtor: liga os módulos ao estado da máquina e inicializa ponteiros e flags
+Chip8::Chip8(bool verbose) : state{}, memory(state.ram, verbose), display(state.display), input(state.input),
+    cpu(nullptr), clock_speed(Config::CPU::DEFAULT_CLOCK_SPEED), instructions_per_frame(0), initialized(false) {}
 
 Chip8::~Chip8() {
     if (cpu) delete cpu;
-    if (display) delete display;
 }
 
-// Inicializa todos os módulos
-void Chip8::initialize(int scale, int clock) {
+// Inicializa todos os módulos sobre a plataforma dada
+void Chip8::initialize(Platform& platform, int clock) {
     if (initialized) return;
-    this->scale = scale;
     this->clock_speed = clock;
-    display = new Display(scale);
-    cpu = new CPU(memory, *display, input, audio);
+    // Clock arredondado para instruções por quadro (ao menos uma)
+    instructions_per_frame = std::max(1, (clock + Config::CPU::TIMER_FREQUENCY / 2) / Config::CPU::TIMER_FREQUENCY);
+    cpu = new CPU(state.cpu, memory, display, input);
+    audio_outputs.push_back(&platform.audio());
     cpu->set_clock_speed(clock);
     initialized = true;
 }
@@ -33,22 +35,160 @@ bool Chip8::load_rom(const std::string& path, uint16_t load_address) {
     return true;
 }
 
+// Carrega uma ROM já lida
+bool Chip8::load_rom(const std::vector<uint8_t>& data, uint16_t load_address) {
+    if (!memory.load_rom(data.data(), data.size(), load_address)) return false;
+    cpu->reset();
+    return true;
+}
+
+// Define a semente do gerador pseudoaleatório
+void Chip8::set_seed(uint32_t seed) {
+    if (initialized) cpu->set_seed(seed);
+}
+
+// Copia o estado completo da máquina para snapshot
+void Chip8::save_state(Snapshot& snapshot) const {
+    if (!initialized) return;
+    cpu->save_state(snapshot.cpu);
+    snapshot.rows = display.get_rows();
+    snapshot.ram = memory.get_ram();
+    snapshot.keys = input.get_key_mask();
+}
+
+// Restaura o estado completo da máquina
+void Chip8::load_state(const Snapshot& snapshot) {
+    if (!initialized) return;
+    memory.load_ram(snapshot.ram);
+    cpu->load_state(snapshot.cpu);
+    display.set_rows(snapshot.rows);
+    input.set_key_mask(snapshot.keys);
+}
+
+// Restaura um clone do estado emulado
+void Chip8::load_state(const MachineState& in) {
+    if (!initialized) return;
+    memory.load_ram(in.ram);
+    cpu->load_state(in.cpu);
+    display.set_rows(in.display.rows); // As linhas que diferem ficam sujas para a apresentação
+    state.input = in.input;
+}
+
+// Liga/desliga o salto de laços ociosos
+void Chip8::set_idle_skip(bool enabled) {
+    if (initialized) cpu->set_idle_skip(enabled);
+}
+
+// Instruções de laços ociosos contadas sem executar
+uint64_t Chip8::get_idle_cycles() const {
+    return initialized ? cpu->get_idle_cycles() : 0;
+}
+
+// Liga/desliga a fusão de instruções
+void Chip8::set_fusion(bool enabled) {
+    if (initialized) cpu->set_fusion(enabled);
+}
+
+// Execuções de cada sequência fundida
+std::array<uint64_t, FUSION_COUNT> Chip8::get_fusion_hits() const {
+    if (!initialized) return {};
+    return cpu->get_fusion_hits();
+}
+
+// Blocos do JIT marcados para o interpretador
+int Chip8::get_jit_interpreted_blocks() const {
+    return initialized ? cpu->get_jit_interpreted_blocks() : 0;
+}
+
+// Liga/desliga o trace de execução
+void Chip8::set_exec_trace(bool enabled) {
+    if (initialized) cpu->set_exec_trace(enabled);
+}
+
+// Liga o profiler
+void Chip8::set_profiler(Profiler* profiler) {
+    if (initialized) cpu->set_profiler(profiler);
+}
+
 // Executa um ciclo de CPU
 void Chip8::emulate_cycle() {
     if (initialized) cpu->emulate_cycle();
 }
 
+// Executa até n ciclos de CPU de uma vez
+int Chip8::run_cycles(int n) {
+    return initialized ? cpu->run(n) : 0;
+}
+
+// Seleciona o motor de execução da CPU
+bool Chip8::set_cpu_backend(CpuBackend backend) {
+    return initialized && cpu->set_backend(backend);
+}
+
 // Atualiza timers
 void Chip8::update_timers() {
     if (initialized) cpu->update_timers();
 }
 
-// Processa eventos de teclado
-void Chip8::handle_input(const SDL_Event& event) {
-    input.handle_event(event);
+// Define quantas instruções são executadas por quadro de 60 Hz
+void Chip8::set_instructions_per_frame(int ipf) {
+    if (ipf > 0) instructions_per_frame = ipf;
+}
+
+// Executa um quadro emulado: as instruções do quadro e um tick dos timers
+int Chip8::run_frame() {
+    if (!initialized) return 0;
+    int executed = cpu->run(instructions_per_frame);
+    input.take_presses(); // Toques entre quadros valem só para o quadro seguinte
+    // O beep soa no quadro em que o sound timer está ativo (antes do decremento)
+    bool tone_on = cpu->is_sound_active();
+    cpu->update_timers();
+    render_audio(tone_on);
+    return executed;
+}
+
+// Acrescenta uma saída de áudio além da plataforma
+void Chip8::add_audio_output(Audio& output) {
+    audio_outputs.push_back(&output);
+}
+
+// Gera as amostras do quadro e entrega às saídas habilitadas
+void Chip8::render_audio(bool tone_on) {
+    bool enabled = false;
+    for (Audio* output : audio_outputs) enabled |= output->is_enabled();
+    if (!enabled) return;
+    size_t count = synth.render_frame(tone_on);
+    for (Audio* output : audio_outputs) {
+        if (output->is_enabled()) output->queue_samples(synth.data(), count);
+    }
+}
+
+// Aplica teclas vindas de outra thread, reproduzindo os toques
+void Chip8::apply_keys(uint16_t mask, uint16_t presses) {
+    for (uint8_t key = 0; key < 16; ++key) {
+        bool down = (mask >> key) & 1;
+        if ((presses >> key) & 1) {
+            input.set_key(key, false);
+            input.set_key(key, true);
+        }
+        input.set_key(key, down);
+    }
+}
+
+// Copia o framebuffer se ele mudou desde a última cópia
+bool Chip8::take_frame(std::array<uint64_t, Display::HEIGHT>& rows) {
+    if (!display.is_dirty()) return false;
+    rows = display.get_rows();
+    display.clear_dirty();
+    return true;
+}
+
+// CPU parada em FX0A
+bool Chip8::is_waiting_for_key() const {
+    return initialized && cpu->is_waiting_for_key();
 }
 
-// Atualiza o display
-void Chip8::draw() {
-    if (initialized) display->render();
+// CPU parada em FX0A com os timers zerados
+bool Chip8::is_quiescent() const {
+    return initialized && cpu->is_quiescent();
 }
@@ -0,0 +1,69 @@
+// API C do ambiente vetorizado: embrulha VecEnv para bibliotecas compartilhadas (ctypes, cffi)
+
+#include "../include/chip8_vec_env.h"
+#include "../include/vec_env.h"
+#include <exception>
+#include <iostream>
+
+struct chip8_vec_env {
+    VecEnv env;
+};
+
+chip8_vec_env* chip8_vec_env_create(const uint8_t* rom, size_t rom_size, int num_envs,
+                                    uint32_t seed, int ipf, int backend, unsigned threads) {
+    if (!rom || rom_size == 0) {
+        std::cerr << "[VecEnv] ERRO: ROM vazia" << std::endl;
+        return nullptr;
+    }
+    VecEnvOptions options;
+    options.seed = seed;
+    options.ipf = ipf;
+    options.backend = backend == CHIP8_VEC_ENV_JIT ? CpuBackend::Jit : CpuBackend::Interpreter;
+    options.threads = threads;
+    try {
+        return new chip8_vec_env{VecEnv(std::vector<uint8_t>(rom, rom + rom_size), num_envs, options)};
+    } catch (const std::exception& e) {
+        std::cerr << "[VecEnv] ERRO: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+void chip8_vec_env_destroy(chip8_vec_env* env) {
+    delete env;
+}
+
+int chip8_vec_env_num_envs(const chip8_vec_env* env) {
+    return env->env.size();
+}
+
+void chip8_vec_env_reset(chip8_vec_env* env, const uint32_t* seeds) {
+    env->env.reset(seeds);
+}
+
+int chip8_vec_env_reset_one(chip8_vec_env* env, int index, uint32_t seed) {
+    if (index < 0 || index >= env->env.size()) return -1;
+    env->env.reset_one(index, seed);
+    return 0;
+}
+
+int chip8_vec_env_step(chip8_vec_env* env, const uint16_t* key_masks, int frames) {
+    if (frames < 0) return -1;
+    env->env.step(key_masks, frames);
+    return 0;
+}
+
+size_t chip8_vec_env_frame_bytes(void) {
+    return VecEnv::FRAME_BYTES;
+}
+
+const uint8_t* chip8_vec_env_framebuffers(const chip8_vec_env* env) {
+    return env->env.framebuffers();
+}
+
+const uint8_t* chip8_vec_env_sound(const chip8_vec_env* env) {
+    return env->env.sound();
+}
+
+const uint8_t* chip8_vec_env_waiting(const chip8_vec_env* env) {
+    return env->env.waiting();
+}
@@ -2,28 +2,38 @@
 // Implementa o ciclo fetch-decode-execute e todos os opcodes
 
 #include "../include/cpu.h"
+#include "../include/jit.h"
+#include "../include/aot.h"
 #include <iostream>
-#include <cstdlib>
 #include <ctime>
+#include <algorithm>
 
 // Construtor: inicializa CPU e seus componentes
-CPU::CPU(Memory& memory, Display& display, Input& input, Audio& audio)
-    : memory(memory), display(display), input(input), audio(audio), clock_speed(Config::CPU::DEFAULT_CLOCK_SPEED) {
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
+CPU::CPU(CpuState& state, Memory& memory, Display& display, Input& input)
+    : state(state), memory(memory), display(display), input(input), clock_speed(Config::CPU::DEFAULT_CLOCK_SPEED),
+      rng(state.rng_state), trace(state.PC, memory.get_ram().data()) {
+    rng.set_seed(static_cast<uint32_t>(std::time(nullptr)));
+    invalidate_cache(0, Memory::MEMORY_SIZE);
+    memory.set_write_listener(&CPU::on_memory_write, this);
     reset();
 }
 
-CPU::~CPU() {}
+CPU::~CPU() {
+    memory.set_write_listener(nullptr, nullptr);
+}
 
 // Reinicia a CPU para o estado inicial
 void CPU::reset() {
-    V.fill(0);
-    I = 0;
-    PC = Memory::PROGRAM_START;
-    SP = 0;
-    stack.fill(0);
-    delay_timer = 0;
-    sound_timer = 0;
+    state.V.fill(0);
+    state.I = 0;
+    state.PC = Memory::PROGRAM_START;
+    state.SP = 0;
+    state.stack.fill(0);
+    state.delay_timer = 0;
+    state.sound_timer = 0;
+    state.key_wait_reg = -1;
+    state.key_wait_held = 0;
+    state.key_wait_pressed = 0;
     display.clear();
 }
 
@@ -32,166 +42,621 @@ void CPU::set_clock_speed(int hz) {
     if (hz > 0) clock_speed = hz;
 }
 
+// Retorna a instrução decodificada em pc, decodificando em caso de falta no cache
+inline const CPU::DecodedInstruction& CPU::fetch(uint16_t pc) {
+    DecodedInstruction& inst = decode_cache[pc];
+    if (!inst.handler) {
+        inst = decode((memory.read(pc) << 8) | memory.read(pc + 1));
+        if (inst.op == Op::JP && idle_skip) inst.idle_loop = is_idle_loop_candidate(pc, inst.nnn);
+        if (fusion) {
+            Fusion fused = detect_fusion(pc, inst);
+            if (fused != Fusion::NONE) inst.label = static_cast<uint8_t>(OP_COUNT + static_cast<size_t>(fused));
+        }
+    }
+    return inst;
+}
+
 // Executa um ciclo de instrução
 void CPU::emulate_cycle() {
-    // Fetch
-    uint16_t opcode = (memory.read(PC) << 8) | memory.read(PC + 1);
-    PC += 2;
+    // Fetch & decode pelo cache (o opcode ocupa PC e PC + 1)
+    if (state.PC < Memory::MEMORY_SIZE - 1) {
+        const DecodedInstruction& inst = fetch(state.PC);
+        state.PC += 2;
 
-    // Decode & Execute
+        // Execute
+        inst.handler(*this, inst);
+        return;
+    }
+
+    // PC fora da memória: caminho sem cache (a política de acesso dá a volta ou acusa o erro)
+    uint16_t opcode = (memory.read(state.PC) << 8) | memory.read(state.PC + 1);
+    state.PC += 2;
     execute_opcode(opcode);
 }
 
+// Executa até max_cycles instruções no motor selecionado
+int CPU::run(int max_cycles) {
+    TraceRing::Scope scope(trace);
+    // FX0A pendente: sem tecla solta desde o último quadro, o orçamento inteiro passa em espera
+    if (state.key_wait_reg >= 0 && !resolve_key_wait()) return idle_key_wait(max_cycles);
+    if (exec_trace) return run_traced(max_cycles);
+    if (profiler) return run_interpreter<true>(max_cycles);
+    if (jit) return jit->run(max_cycles);
+    if (aot) return aot->run(max_cycles);
+    return run_interpreter<false>(max_cycles);
+}
+
+// Seleciona o motor de execução
+bool CPU::set_backend(CpuBackend backend) {
+    if (backend == CpuBackend::Interpreter) {
+        jit.reset();
+        aot.reset();
+        return true;
+    }
+    if (backend == CpuBackend::Aot) {
+        const AotProgram* program = Aot::find_program(memory.get_ram());
+        if (!program) {
+            std::cerr << "[CPU] AVISO: nenhum programa AOT ligado a este executável corresponde à ROM, usando o interpretador" << std::endl;
+            return false;
+        }
+        jit.reset();
+        aot.reset(new Aot(*this, *program));
+        return true;
+    }
+    if (!Jit::is_supported()) {
+        std::cerr << "[CPU] AVISO: JIT não suportado neste host, usando o interpretador" << std::endl;
+        return false;
+    }
+    aot.reset();
+    if (!jit) jit.reset(new Jit(*this));
+    return true;
+}
+
+// Define a semente do gerador usado por CXKK
+void CPU::set_seed(uint32_t seed) {
+    rng.set_seed(seed);
+}
+
 // Atualiza os timers
 void CPU::update_timers() {
-    if (delay_timer > 0) --delay_timer;
-    if (sound_timer > 0) {
-        if (sound_timer == 1) audio.start_beep();
-        --sound_timer;
-    } else {
-        audio.stop_beep();
+    if (state.delay_timer > 0) --state.delay_timer;
+    if (state.sound_timer > 0) --state.sound_timer;
+}
+
+// Executa instrução por instrução, registrando cada uma no trace (e no profiler, se ligado)
+int CPU::run_traced(int max_cycles) {
+    for (int i = 0; i < max_cycles; ++i) {
+        uint16_t opcode = state.PC + 1 < Memory::MEMORY_SIZE ? (memory.read(state.PC) << 8) | memory.read(state.PC + 1) : 0;
+        trace.emit_exec(state.PC, opcode);
+        if (profiler && state.PC < Memory::MEMORY_SIZE - 1) profiler->record(state.PC, opcode, fetch(state.PC).op, state.I, state.SP);
+        emulate_cycle();
+        if (state.key_wait_reg >= 0) return i + 1 + idle_key_wait(max_cycles - i - 1);
     }
+    return max_cycles;
+}
+
+// Confere a espera do FX0A contra as teclas atuais
+bool CPU::resolve_key_wait() {
+    uint16_t mask = input.get_key_mask();
+    uint16_t presses = input.take_presses();
+    // Teclas seguradas desde a entrada só contam depois de soltas e pressionadas de novo
+    state.key_wait_held &= mask & ~presses;
+    state.key_wait_pressed |= (mask | presses) & ~state.key_wait_held;
+    uint16_t released = state.key_wait_pressed & ~mask;
+    if (!released) return false;
+    state.V[state.key_wait_reg] = static_cast<uint8_t>(__builtin_ctz(released));
+    state.key_wait_reg = -1;
+    state.key_wait_pressed = 0;
+    state.PC += 2;
+    return true;
+}
+
+// FX0A em espera: o restante do quadro é contado como ocioso
+int CPU::idle_key_wait(int remaining) {
+    if (remaining <= 0) return 0;
+    idle_cycles += remaining;
+    if (profiler) profiler->record_idle(state.PC, remaining);
+    return remaining;
 }
 
 // Decodifica e executa um opcode
 void CPU::execute_opcode(uint16_t opcode) {
-    uint8_t x = (opcode & 0x0F00) >> 8;
-    uint8_t y = (opcode & 0x00F0) >> 4;
-    uint8_t n = opcode & 0x000F;
-    uint8_t kk = opcode & 0x00FF;
-    uint16_t nnn = opcode & 0x0FFF;
-
-    switch (opcode & 0xF000) {
-        case 0x0000: execute_0xxx(opcode); break;
-        case 0x1000: PC = nnn; break; // 1NNN: JP addr
-        case 0x2000: // 2NNN: CALL addr
-            if (SP >= Config::CPU::STACK_SIZE) {
-                std::cerr << "[CPU] ERRO: Stack overflow!" << std::endl;
-                return;
-            }
-            stack[SP++] = PC;
-            PC = nnn;
+    DecodedInstruction inst = decode(opcode);
+    inst.handler(*this, inst);
+}
+
+// Invalida as entradas do cache que cobrem [address, address + length)
+void CPU::invalidate_cache(uint16_t address, uint16_t length, WriteSource source) {
+    // A instrução em address - 1 também lê o byte em address, e uma fusão decidida em pc lê até
+    // pc + FUSION_SPAN - 1
+    uint32_t first = address >= FUSION_SPAN - 1 ? address - (FUSION_SPAN - 1u) : 0u;
+    uint32_t last = std::min<uint32_t>(uint32_t(address) + length, Memory::MEMORY_SIZE);
+    for (uint32_t a = first; a < last; ++a) decode_cache[a].handler = nullptr;
+    if (jit) jit->invalidate(address, length, source == WriteSource::Guest);
+    if (aot) aot->invalidate(address, length);
+}
+
+// Callback de escrita da memória
+void CPU::on_memory_write(void* userdata, uint16_t address, uint16_t length, WriteSource source) {
+    static_cast<CPU*>(userdata)->invalidate_cache(address, length, source);
+}
+
+// Decodifica um opcode, extraindo operandos e escolhendo o handler
+CPU::DecodedInstruction CPU::decode(uint16_t opcode) {
+    DecodedInstruction d;
+    d.opcode = opcode;
+    d.x = (opcode & 0x0F00) >> 8;
+    d.y = (opcode & 0x00F0) >> 4;
+    d.n = opcode & 0x000F;
+    d.kk = opcode & 0x00FF;
+    d.nnn = opcode & 0x0FFF;
+    d.op = OPCODE_TABLE[opcode];
+    d.handler = HANDLERS[static_cast<size_t>(d.op)];
+    d.idle_loop = false;
+    d.label = static_cast<uint8_t>(d.op);
+    return d;
+}
+
+// Sequência fundida que começa em pc (Fusion::NONE se não houver)
+Fusion CPU::detect_fusion(uint16_t pc, const DecodedInstruction& first) {
+    if (pc + 2 >= Memory::MEMORY_SIZE - 1) return Fusion::NONE;
+    uint16_t next = (memory.read(pc + 2) << 8) | memory.read(pc + 3);
+    Op next_op = OPCODE_TABLE[next];
+    uint8_t next_x = (next & 0x0F00) >> 8;
+
+    Fusion fused = Fusion::NONE;
+    switch (first.op) {
+        case Op::LD_I:
+            if (next_op == Op::DRW) fused = Fusion::LD_I_DRW;
+            else if (next_op == Op::LD_VX_MEM) fused = Fusion::LD_I_LOAD;
+            else if (next_op == Op::LD_MEM_VX) fused = Fusion::LD_I_STORE;
+            break;
+        case Op::LD_BYTE:
+            if (next_op == Op::LD_DT_VX && next_x == first.x) fused = Fusion::LD_DT_BYTE;
             break;
-        case 0x3000: if (V[x] == kk) PC += 2; break; // 3XKK: SE Vx, byte
-        case 0x4000: if (V[x] != kk) PC += 2; break; // 4XKK: SNE Vx, byte
-        case 0x5000: if (V[x] == V[y]) PC += 2; break; // 5XY0: SE Vx, Vy
-        case 0x6000: V[x] = kk; break; // 6XKK: LD Vx, byte
-        case 0x7000: V[x] += kk; break; // 7XKK: ADD Vx, byte
-        case 0x8000: execute_8xxx(opcode); break;
-        case 0x9000: if (V[x] != V[y]) PC += 2; break; // 9XY0: SNE Vx, Vy
-        case 0xA000: I = nnn; break; // ANNN: LD I, addr
-        case 0xB000: PC = nnn + V[0]; break; // BNNN: JP V0, addr
-        case 0xC000: V[x] = (std::rand() % 256) & kk; break; // CXKK: RND Vx, byte
-        case 0xD000: { // DXYN: DRW Vx, Vy, nibble
-            // Lê N bytes a partir de I e desenha como sprite na tela
-            uint8_t sprite_buf[15] = {0};
-            for (uint8_t row = 0; row < n; ++row) {
-                sprite_buf[row] = memory.read(I + row);
+        case Op::LD_B:
+            if (next_op == Op::LD_VX_MEM) fused = Fusion::BCD_LOAD;
+            break;
+        case Op::ADD_BYTE:
+            // O JP não pode fechar um laço ocioso: esse caminho fica com o despacho normal
+            if (next_op == Op::SE_BYTE && next_x == first.x && pc + 4 < Memory::MEMORY_SIZE - 1) {
+                const DecodedInstruction& jump = fetch(pc + 4);
+                if (jump.op == Op::JP && !jump.idle_loop) fused = Fusion::COUNTED_LOOP;
             }
-            bool collision = display.draw_sprite(V[x], V[y], sprite_buf, n);
-            V[0xF] = collision ? 1 : 0;
             break;
-        }
-        case 0xE000: execute_Exxx(opcode); break;
-        case 0xF000: execute_Fxxx(opcode); break;
         default:
-            std::cerr << "[CPU] ERRO: Opcode desconhecido: 0x" << std::hex << opcode << std::dec << std::endl;
             break;
     }
+    // A segunda instrução nunca inicia uma fusão, então a decodificação não encadeia
+    if (fused != Fusion::NONE) fetch(pc + 2);
+    return fused;
 }
 
-// Executa opcodes 0xxx (operações de controle de tela e retorno de sub-rotina)
-void CPU::execute_0xxx(uint16_t opcode) {
-    switch (opcode) {
-        case 0x00E0: display.clear(); break; // 00E0: CLS
-        case 0x00EE: // 00EE: RET
-            if (SP == 0) {
-                std::cerr << "[CPU] ERRO: Stack underflow!" << std::endl;
-                return;
-            }
-            PC = stack[--SP];
-            break;
-        default:
-            std::cerr << "[CPU] ERRO: Opcode 0xxx desconhecido: 0x" << std::hex << opcode << std::dec << std::endl;
-            break;
+namespace {
+// Instruções que só leem V, DT e teclas e só escrevem em V (o corpo de um laço ocioso);
+// um JP no corpo só mantém o laço se voltar ao início (conferido na simulação)
+bool is_idle_loop_op(Op op) {
+    switch (op) {
+        case Op::JP: case Op::SE_BYTE: case Op::SNE_BYTE: case Op::SE_REG: case Op::SNE_REG:
+        case Op::SKP: case Op::SKNP: case Op::LD_VX_DT: case Op::LD_BYTE: return true;
+        default: return false;
     }
 }
+}
 
-// Executa opcodes 8xxx (operações aritméticas e lógicas entre registradores
-void CPU::execute_8xxx(uint16_t opcode) {
-    uint8_t x = (opcode & 0x0F00) >> 8;
-    uint8_t y = (opcode & 0x00F0) >> 4;
+// Indica se o JP em pc para target fecha um laço candidato a ocioso
+bool CPU::is_idle_loop_candidate(uint16_t pc, uint16_t target) const {
+    if (target > pc || (pc - target) / 2 >= Config::CPU::MAX_IDLE_LOOP) return false;
+    for (uint16_t a = target; a < pc; a += 2) {
+        if (!is_idle_loop_op(OPCODE_TABLE[(memory.read(a) << 8) | memory.read(a + 1)])) return false;
+    }
+    return true;
+}
 
-    switch (opcode & 0x000F) {
-        case 0x0: V[x] = V[y]; break; // 8XY0: LD Vx, Vy
-        case 0x1: V[x] |= V[y]; break; // 8XY1: OR Vx, Vy
-        case 0x2: V[x] &= V[y]; break; // 8XY2: AND Vx, Vy
-        case 0x3: V[x] ^= V[y]; break; // 8XY3: XOR Vx, Vy
-        case 0x4: { // 8XY4: ADD Vx, Vy
-            uint16_t sum = V[x] + V[y];
-            V[0xF] = (sum > 0xFF) ? 1 : 0;
-            V[x] = sum & 0xFF;
-            break;
+// Simula uma iteração a partir de PC em uma cópia de V: se o laço volta ao início com o
+// mesmo estado, nada muda até o próximo tick dos timers ou evento de teclado
+int CPU::skip_idle_loop(int remaining) {
+    std::array<uint8_t, 16> v = state.V;
+    uint16_t pc = state.PC;
+    for (int steps = 1; steps <= Config::CPU::MAX_IDLE_LOOP && pc < Memory::MEMORY_SIZE - 1; ++steps) {
+        uint16_t opcode = (memory.read(pc) << 8) | memory.read(pc + 1);
+        uint8_t x = (opcode & 0x0F00) >> 8;
+        uint8_t y = (opcode & 0x00F0) >> 4;
+        uint8_t kk = opcode & 0x00FF;
+        pc += 2;
+        switch (OPCODE_TABLE[opcode]) {
+            case Op::JP:
+                if ((opcode & 0x0FFF) != state.PC || v != state.V) return 0;
+                {
+                    int skipped = remaining / steps * steps;
+                    idle_cycles += skipped;
+                    return skipped;
+                }
+            case Op::SE_BYTE: if (v[x] == kk) pc += 2; break;
+            case Op::SNE_BYTE: if (v[x] != kk) pc += 2; break;
+            case Op::SE_REG: if (v[x] == v[y]) pc += 2; break;
+            case Op::SNE_REG: if (v[x] != v[y]) pc += 2; break;
+            case Op::SKP: if (v[x] > 0xF) return 0; if (input.is_pressed(v[x])) pc += 2; break;
+            case Op::SKNP: if (v[x] > 0xF) return 0; if (!input.is_pressed(v[x])) pc += 2; break;
+            case Op::LD_VX_DT: v[x] = state.delay_timer; break;
+            case Op::LD_BYTE: v[x] = kk; break;
+            default: return 0;
         }
-        case 0x5: // 8XY5: SUB Vx, Vy
-            V[0xF] = (V[x] > V[y]) ? 1 : 0;
-            V[x] -= V[y];
-            break;
-        case 0x6: // 8XY6: SHR Vx
-            V[0xF] = V[x] & 0x1;
-            V[x] >>= 1;
-            break;
-        case 0x7: // 8XY7: SUBN Vx, Vy
-            V[0xF] = (V[y] > V[x]) ? 1 : 0;
-            V[x] = V[y] - V[x];
-            break;
-        case 0xE: // 8XYE: SHL Vx
-            V[0xF] = (V[x] & 0x80) >> 7;
-            V[x] <<= 1;
-            break;
-        default:
-            std::cerr << "[CPU] ERRO: Opcode 8xxx desconhecido: 0x" << std::hex << opcode << std::dec << std::endl;
-            break;
     }
+    return 0;
 }
 
-// Executa opcodes Exxx (verificações de teclas pressionadas)
-void CPU::execute_Exxx(uint16_t opcode) {
-    uint8_t x = (opcode & 0x0F00) >> 8;
+// Liga/desliga a fusão de instruções
+void CPU::set_fusion(bool enabled) {
+    if (fusion == enabled) return;
+    fusion = enabled;
+    invalidate_cache(0, Memory::MEMORY_SIZE);
+}
 
-    switch (opcode & 0x00FF) {
-        case 0x9E: if (input.is_pressed(V[x])) PC += 2; break; // EX9E: SKP Vx
-        case 0xA1: if (!input.is_pressed(V[x])) PC += 2; break; // EXA1: SKNP Vx
-        default:
-            std::cerr << "[CPU] ERRO: Opcode Exxx desconhecido: 0x" << std::hex << opcode << std::dec << std::endl;
-            break;
+// Blocos do JIT que voltaram ao interpretador
+int CPU::get_jit_interpreted_blocks() const {
+    return jit ? jit->interpreted_blocks() : 0;
+}
+
+// Copia os registradores para out
+void CPU::save_state(CpuState& out) const {
+    out = state;
+}
+
+// Restaura os registradores de in
+void CPU::load_state(const CpuState& in) {
+    state = in;
+    rng.set_state(in.rng_state); // Semente 0 é trocada, como em set_seed
+    if (profiler) profiler->reset_stack(); // A pilha restaurada não corresponde à árvore de chamadas
+}
+
+// Liga/desliga o salto de laços ociosos
+void CPU::set_idle_skip(bool enabled) {
+    if (idle_skip == enabled) return;
+    idle_skip = enabled;
+    // Recalcula as marcas de laço nas entradas já decodificadas (e recompila os blocos)
+    invalidate_cache(0, Memory::MEMORY_SIZE);
+}
+
+// 00E0: CLS
+template <> void CPU::exec<Op::CLS>(CpuState&, const DecodedInstruction&) { display.clear(); }
+
+// 00EE: RET
+template <> void CPU::exec<Op::RET>(CpuState& regs, const DecodedInstruction&) {
+    if (regs.SP == 0) {
+        trace.emit(TraceKind::StackUnderflow);
+        return;
     }
+    regs.PC = regs.stack[--regs.SP];
 }
 
-// Executa opcodes Fxxx (timers, sprites, decimal codificado em binário e operações de memória com registradores)
-void CPU::execute_Fxxx(uint16_t opcode) {
-    uint8_t x = (opcode & 0x0F00) >> 8;
+// 1NNN: JP addr
+template <> void CPU::exec<Op::JP>(CpuState& regs, const DecodedInstruction& d) { regs.PC = d.nnn; }
 
-    switch (opcode & 0x00FF) {
-        case 0x07: V[x] = delay_timer; break; // FX07: LD Vx, DT
-        case 0x0A: V[x] = input.wait_for_key(); break; // FX0A: LD Vx, K
-        case 0x15: delay_timer = V[x]; break; // FX15: LD DT, Vx
-        case 0x18: sound_timer = V[x]; break; // FX18: LD ST, Vx
-        case 0x1E: I += V[x]; break; // FX1E: ADD I, Vx
-        case 0x29: I = memory.get_font_address(V[x]); break; // FX29: LD F, Vx
-        case 0x33: // FX33: LD B, Vx (BCD)
-            memory.write(I, V[x] / 100);
-            memory.write(I + 1, (V[x] / 10) % 10);
-            memory.write(I + 2, V[x] % 10);
-            break;
-        case 0x55: // FX55: LD [I], Vx
-            for (int i = 0; i <= x; ++i) memory.write(I + i, V[i]);
-            break;
-        case 0x65: // FX65: LD Vx, [I]
-            for (int i = 0; i <= x; ++i) V[i] = memory.read(I + i);
-            break;
-        default:
-            std::cerr << "[CPU] ERRO: Opcode Fxxx desconhecido: 0x" << std::hex << opcode << std::dec << std::endl;
-            break;
+// 2NNN: CALL addr
+template <> void CPU::exec<Op::CALL>(CpuState& regs, const DecodedInstruction& d) {
+    if (regs.SP >= Config::CPU::STACK_SIZE) {
+        trace.emit(TraceKind::StackOverflow);
+        return;
+    }
+    regs.stack[regs.SP++] = regs.PC;
+    regs.PC = d.nnn;
+}
+
+// 3XKK: SE Vx, byte
+template <> void CPU::exec<Op::SE_BYTE>(CpuState& regs, const DecodedInstruction& d) { if (regs.V[d.x] == d.kk) regs.PC += 2; }
+
+// 4XKK: SNE Vx, byte
+template <> void CPU::exec<Op::SNE_BYTE>(CpuState& regs, const DecodedInstruction& d) { if (regs.V[d.x] != d.kk) regs.PC += 2; }
+
+// 5XY0: SE Vx, Vy
+template <> void CPU::exec<Op::SE_REG>(CpuState& regs, const DecodedInstruction& d) { if (regs.V[d.x] == regs.V[d.y]) regs.PC += 2; }
+
+// 6XKK: LD Vx, byte
+template <> void CPU::exec<Op::LD_BYTE>(CpuState& regs, const DecodedInstruction& d) { regs.V[d.x] = d.kk; }
+
+// 7XKK: ADD Vx, byte
+template <> void CPU::exec<Op::ADD_BYTE>(CpuState& regs, const DecodedInstruction& d) { regs.V[d.x] += d.kk; }
+
+// 8XY0: LD Vx, Vy
+template <> void CPU::exec<Op::LD_REG>(CpuState& regs, const DecodedInstruction& d) { regs.V[d.x] = regs.V[d.y]; }
+
+// 8XY1: OR Vx, Vy
+template <> void CPU::exec<Op::OR>(CpuState& regs, const DecodedInstruction& d) { regs.V[d.x] |= regs.V[d.y]; }
+
+// 8XY2: AND Vx, Vy
+template <> void CPU::exec<Op::AND>(CpuState& regs, const DecodedInstruction& d) { regs.V[d.x] &= regs.V[d.y]; }
+
+// 8XY3: XOR Vx, Vy
+template <> void CPU::exec<Op::XOR>(CpuState& regs, const DecodedInstruction& d) { regs.V[d.x] ^= regs.V[d.y]; }
+
+// 8XY4: ADD Vx, Vy
+template <> void CPU::exec<Op::ADD_REG>(CpuState& regs, const DecodedInstruction& d) {
+    uint16_t sum = regs.V[d.x] + regs.V[d.y];
+    regs.V[0xF] = (sum > 0xFF) ? 1 : 0;
+    regs.V[d.x] = sum & 0xFF;
+}
+
+// 8XY5: SUB Vx, Vy
+template <> void CPU::exec<Op::SUB>(CpuState& regs, const DecodedInstruction& d) {
+    regs.V[0xF] = (regs.V[d.x] > regs.V[d.y]) ? 1 : 0;
+    regs.V[d.x] -= regs.V[d.y];
+}
+
+// 8XY6: SHR Vx
+template <> void CPU::exec<Op::SHR>(CpuState& regs, const DecodedInstruction& d) {
+    regs.V[0xF] = regs.V[d.x] & 0x1;
+    regs.V[d.x] >>= 1;
+}
+
+// 8XY7: SUBN Vx, Vy
+template <> void CPU::exec<Op::SUBN>(CpuState& regs, const DecodedInstruction& d) {
+    regs.V[0xF] = (regs.V[d.y] > regs.V[d.x]) ? 1 : 0;
+    regs.V[d.x] = regs.V[d.y] - regs.V[d.x];
+}
+
+// 8XYE: SHL Vx
+template <> void CPU::exec<Op::SHL>(CpuState& regs, const DecodedInstruction& d) {
+    regs.V[0xF] = (regs.V[d.x] & 0x80) >> 7;
+    regs.V[d.x] <<= 1;
+}
+
+// 9XY0: SNE Vx, Vy
+template <> void CPU::exec<Op::SNE_REG>(CpuState& regs, const DecodedInstruction& d) { if (regs.V[d.x] != regs.V[d.y]) regs.PC += 2; }
+
+// ANNN: LD I, addr
+template <> void CPU::exec<Op::LD_I>(CpuState& regs, const DecodedInstruction& d) { regs.I = d.nnn; }
+
+// BNNN: JP V0, addr
+template <> void CPU::exec<Op::JP_V0>(CpuState& regs, const DecodedInstruction& d) { regs.PC = d.nnn + regs.V[0]; }
+
+// CXKK: RND Vx, byte
+template <> void CPU::exec<Op::RND>(CpuState& regs, const DecodedInstruction& d) { regs.V[d.x] = rng.next_byte() & d.kk; }
+
+// DXYN: DRW Vx, Vy, nibble
+template <> void CPU::exec<Op::DRW>(CpuState& regs, const DecodedInstruction& d) {
+    // Lê N bytes a partir de I e desenha como sprite na tela
+    uint8_t sprite_buf[15] = {0};
+    for (uint8_t row = 0; row < d.n; ++row) {
+        sprite_buf[row] = memory.read(regs.I + row);
+    }
+    bool collision = display.draw_sprite(regs.V[d.x], regs.V[d.y], sprite_buf, d.n);
+    regs.V[0xF] = collision ? 1 : 0;
+}
+
+// EX9E: SKP Vx
+template <> void CPU::exec<Op::SKP>(CpuState& regs, const DecodedInstruction& d) { if (input.is_pressed(regs.V[d.x])) regs.PC += 2; }
+
+// EXA1: SKNP Vx
+template <> void CPU::exec<Op::SKNP>(CpuState& regs, const DecodedInstruction& d) { if (!input.is_pressed(regs.V[d.x])) regs.PC += 2; }
+
+// FX07: LD Vx, DT
+template <> void CPU::exec<Op::LD_VX_DT>(CpuState& regs, const DecodedInstruction& d) { regs.V[d.x] = regs.delay_timer; }
+
+// FX0A: LD Vx, K
+// Entra no estado de espera com o PC parado na instrução; como no COSMAC VIP, a tecla só é
+// entregue quando for solta. Quem resolve é CPU::run, no início de cada quadro
+template <> void CPU::exec<Op::LD_VX_K>(CpuState& regs, const DecodedInstruction& d) {
+    regs.PC -= 2;
+    if (regs.key_wait_reg < 0) {
+        regs.key_wait_reg = static_cast<int8_t>(d.x);
+        regs.key_wait_held = input.get_key_mask();
+        regs.key_wait_pressed = 0;
+        input.take_presses(); // Toques anteriores à instrução não contam
+        return;
+    }
+    resolve_key_wait();
+}
+
+// FX15: LD DT, Vx
+template <> void CPU::exec<Op::LD_DT_VX>(CpuState& regs, const DecodedInstruction& d) { regs.delay_timer = regs.V[d.x]; }
+
+// FX18: LD ST, Vx
+template <> void CPU::exec<Op::LD_ST_VX>(CpuState& regs, const DecodedInstruction& d) { regs.sound_timer = regs.V[d.x]; }
+
+// FX1E: ADD I, Vx
+template <> void CPU::exec<Op::ADD_I>(CpuState& regs, const DecodedInstruction& d) { regs.I += regs.V[d.x]; }
+
+// FX29: LD F, Vx
+template <> void CPU::exec<Op::LD_F>(CpuState& regs, const DecodedInstruction& d) { regs.I = memory.get_font_address(regs.V[d.x]); }
+
+// FX33: LD B, Vx (BCD)
+template <> void CPU::exec<Op::LD_B>(CpuState& regs, const DecodedInstruction& d) {
+    uint8_t value = regs.V[d.x];
+    memory.write(regs.I, value / 100);
+    memory.write(regs.I + 1, (value / 10) % 10);
+    memory.write(regs.I + 2, value % 10);
+}
+
+// FX55: LD [I], Vx
+template <> void CPU::exec<Op::LD_MEM_VX>(CpuState& regs, const DecodedInstruction& d) {
+    for (int i = 0; i <= d.x; ++i) memory.write(regs.I + i, regs.V[i]);
+}
+
+// FX65: LD Vx, [I]
+template <> void CPU::exec<Op::LD_VX_MEM>(CpuState& regs, const DecodedInstruction& d) {
+    for (int i = 0; i <= d.x; ++i) regs.V[i] = memory.read(regs.I + i);
+}
+
+// Opcode desconhecido (vira no-op; o aviso sai pelo trace, sem E/S no laço)
+template <> void CPU::exec<Op::UNKNOWN>(CpuState&, const DecodedInstruction&) { trace.emit(TraceKind::UnknownOpcode); }
+
+// Tabela Op -> handler
+const std::array<CPU::Handler, OP_COUNT> CPU::HANDLERS = {
+#define CHIP8_OP_HANDLER(name, mnemonic) &CPU::handler<Op::name>,
+    CHIP8_OPCODES(CHIP8_OP_HANDLER)
+#undef CHIP8_OP_HANDLER
+};
+
+// Laço do interpretador: cada handler termina saltando direto para o próximo (threaded code)
+#if CHIP8_THREADED_DISPATCH
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+template <bool Profile>
+int CPU::run_interpreter(int max_cycles) {
+    CpuState& regs = state;
+    int executed = 0;
+#if CHIP8_THREADED_DISPATCH
+    static void* const labels[OP_COUNT + FUSION_COUNT] = {
+#define CHIP8_OP_LABEL(name, mnemonic) &&op_##name,
+        CHIP8_OPCODES(CHIP8_OP_LABEL)
+#undef CHIP8_OP_LABEL
+#define CHIP8_FUSION_LABEL(name, sequence, first) &&fuse_##name,
+        CHIP8_FUSIONS(CHIP8_FUSION_LABEL)
+#undef CHIP8_FUSION_LABEL
+    };
+    const DecodedInstruction* inst;
+
+#define CHIP8_DISPATCH()                                           \
+    do {                                                           \
+        if (executed >= max_cycles) return executed;               \
+        if (regs.PC >= Memory::MEMORY_SIZE - 1) goto out_of_range; \
+        inst = &fetch(regs.PC);                                    \
+        regs.PC += 2;                                              \
+        ++executed;                                                \
+        goto *labels[inst->label];                                 \
+    } while (0)
+
+    CHIP8_DISPATCH();
+
+#define CHIP8_OP_CASE(name, mnemonic)                                                        \
+    op_##name:                                                                               \
+        if (Profile) profiler->record(regs.PC - 2, inst->opcode, Op::name, regs.I, regs.SP); \
+        exec<Op::name>(regs, *inst);                                                         \
+        if (Op::name == Op::LD_VX_K && regs.key_wait_reg >= 0) {                             \
+            return executed + idle_key_wait(max_cycles - executed);                          \
+        }                                                                                    \
+        if (Op::name == Op::JP && inst->idle_loop) {                                         \
+            int skipped = skip_idle_loop(max_cycles - executed);                             \
+            if (Profile && skipped) profiler->record_idle(regs.PC, skipped);                 \
+            executed += skipped;                                                             \
+        }                                                                                    \
+        CHIP8_DISPATCH();
+    CHIP8_OPCODES(CHIP8_OP_CASE)
+#undef CHIP8_OP_CASE
+
+    // Sequências fundidas: inst é a primeira instrução (já contada, com o PC depois dela) e as
+    // seguintes vêm direto do cache, decodificadas junto com ela. Sem orçamento para a
+    // sequência inteira, ou com o profiler, a primeira instrução segue avulsa
+#define CHIP8_FUSED_NEXT()               \
+    do {                                 \
+        inst = &decode_cache[regs.PC];   \
+        regs.PC += 2;                    \
+        ++executed;                      \
+    } while (0)
+
+fuse_LD_I_DRW:
+    if (Profile || executed >= max_cycles) goto op_LD_I;
+    regs.I = inst->nnn;
+    CHIP8_FUSED_NEXT();
+    exec<Op::DRW>(regs, *inst);
+    ++fusion_hits[static_cast<size_t>(Fusion::LD_I_DRW)];
+    CHIP8_DISPATCH();
+
+fuse_LD_I_LOAD:
+    if (Profile || executed >= max_cycles) goto op_LD_I;
+    regs.I = inst->nnn;
+    CHIP8_FUSED_NEXT();
+    exec<Op::LD_VX_MEM>(regs, *inst);
+    ++fusion_hits[static_cast<size_t>(Fusion::LD_I_LOAD)];
+    CHIP8_DISPATCH();
+
+fuse_LD_I_STORE:
+    if (Profile || executed >= max_cycles) goto op_LD_I;
+    regs.I = inst->nnn;
+    CHIP8_FUSED_NEXT();
+    exec<Op::LD_MEM_VX>(regs, *inst);
+    ++fusion_hits[static_cast<size_t>(Fusion::LD_I_STORE)];
+    CHIP8_DISPATCH();
+
+fuse_LD_DT_BYTE:
+    if (Profile || executed >= max_cycles) goto op_LD_BYTE;
+    regs.V[inst->x] = inst->kk;
+    regs.delay_timer = inst->kk;
+    regs.PC += 2;
+    ++executed;
+    ++fusion_hits[static_cast<size_t>(Fusion::LD_DT_BYTE)];
+    CHIP8_DISPATCH();
+
+fuse_BCD_LOAD:
+    if (Profile || executed >= max_cycles) goto op_LD_B;
+    exec<Op::LD_B>(regs, *inst);
+    // Os dígitos podem ter sobrescrito o FX65: nesse caso ele é decodificado de novo
+    if (!decode_cache[regs.PC].handler) CHIP8_DISPATCH();
+    CHIP8_FUSED_NEXT();
+    exec<Op::LD_VX_MEM>(regs, *inst);
+    ++fusion_hits[static_cast<size_t>(Fusion::BCD_LOAD)];
+    CHIP8_DISPATCH();
+
+fuse_COUNTED_LOOP: {
+    // 7XKK; 3XKK; 1NNN: a saída custa duas instruções (o SE pula o JP), a volta custa três
+    if (Profile || max_cycles - executed < 2) goto op_ADD_BYTE;
+    uint16_t loop_pc = regs.PC - 2;
+    uint8_t step = inst->kk;
+    uint8_t limit = decode_cache[regs.PC].kk;
+    uint16_t target = decode_cache[regs.PC + 2].nnn;
+    uint8_t& counter = regs.V[inst->x];
+    uint64_t& hits = fusion_hits[static_cast<size_t>(Fusion::COUNTED_LOOP)];
+    counter += step;
+    ++hits;
+    if (counter == limit) {
+        regs.PC += 4;
+        ++executed;
+        CHIP8_DISPATCH();
+    }
+    regs.PC = target;
+    executed += 2;
+    // Laço sobre si mesmo (contador de espera): repete as iterações inteiras que cabem no
+    // orçamento; o resto segue pelo despacho normal
+    if (target == loop_pc) {
+        while (max_cycles - executed >= 3) {
+            counter += step;
+            ++hits;
+            if (counter == limit) {
+                regs.PC = loop_pc + 6;
+                executed += 2;
+                break;
+            }
+            executed += 3;
+        }
+    }
+    CHIP8_DISPATCH();
+}
+#undef CHIP8_FUSED_NEXT
+
+out_of_range:
+    emulate_cycle();
+    ++executed;
+    CHIP8_DISPATCH();
+#undef CHIP8_DISPATCH
+#else
+    while (executed < max_cycles) {
+        if (regs.PC >= Memory::MEMORY_SIZE - 1) {
+            emulate_cycle();
+            ++executed;
+            continue;
+        }
+        const DecodedInstruction& inst = fetch(regs.PC);
+        regs.PC += 2;
+        ++executed;
+        if (Profile) profiler->record(regs.PC - 2, inst.opcode, inst.op, regs.I, regs.SP);
+        switch (inst.op) {
+#define CHIP8_OP_CASE(name, mnemonic) case Op::name: exec<Op::name>(regs, inst); break;
+            CHIP8_OPCODES(CHIP8_OP_CASE)
+#undef CHIP8_OP_CASE
+            default: break;
+        }
+        if (inst.op == Op::LD_VX_K && regs.key_wait_reg >= 0) return executed + idle_key_wait(max_cycles - executed);
+        if (inst.op == Op::JP && inst.idle_loop) {
+            int skipped = skip_idle_loop(max_cycles - executed);
+            if (Profile && skipped) profiler->record_idle(regs.PC, skipped);
+            executed += skipped;
+        }
     }
+    return executed;
+#endif
 }
+#if CHIP8_THREADED_DISPATCH
+#pragma GCC diagnostic pop
+#endif
@@ -1,90 +1,92 @@
 // Módulo de saída gráfica do Chip-8
-// Implementa a tela 64x32 usando SDL2
+// Implementa o framebuffer 64x32 e o desenho de sprites
 
 #include "../include/display.h"
-#include <cstring>
-#include <iostream>
+#include <algorithm>
 
-// Cria o display, inicializando SDL e a janela
-Display::Display(int scale) : scale(scale), pixels(WIDTH * HEIGHT, 0), window(nullptr), renderer(nullptr), texture(nullptr) {
-    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-        std::cerr << "[Display] ERRO: Não foi possível inicializar SDL2: " << SDL_GetError() << std::endl;
-        throw std::runtime_error("Falha ao inicializar SDL2");
-    }
-    window = SDL_CreateWindow("CHIP-8 Emulator", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-                              WIDTH * scale, HEIGHT * scale, SDL_WINDOW_SHOWN);
-    if (!window) {
-        std::cerr << "[Display] ERRO: Não foi possível criar a janela SDL: " << SDL_GetError() << std::endl;
-        SDL_Quit();
-        throw std::runtime_error("Falha ao criar janela SDL");
-    }
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-    if (!renderer) {
-        std::cerr << "[Display] ERRO: Não foi possível criar renderer SDL: " << SDL_GetError() << std::endl;
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-        throw std::runtime_error("Falha ao criar renderer SDL");
-    }
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
-                               WIDTH, HEIGHT);
-    if (!texture) {
-        std::cerr << "[Display] ERRO: Não foi possível criar textura SDL: " << SDL_GetError() << std::endl;
-        SDL_DestroyRenderer(renderer);
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-        throw std::runtime_error("Falha ao criar textura SDL");
-    }
-    clear();
-}
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CHIP8_DISPLAY_SSE2 1
+#endif
 
-// Libera recursos SDL
-Display::~Display() {
-    if (texture) SDL_DestroyTexture(texture);
-    if (renderer) SDL_DestroyRenderer(renderer);
-    if (window) SDL_DestroyWindow(window);
-    SDL_Quit();
+// Liga o display ao estado dado e limpa a tela
+Display::Display(DisplayState& state) : state(state), dirty_rows(ALL_ROWS) {
+    state.rows.fill(0);
 }
 
+Display::~Display() {}
+
 // Limpa a tela
 void Display::clear() {
-    std::fill(pixels.begin(), pixels.end(), 0);
-    render();
+    for (int y = 0; y < HEIGHT; ++y) {
+        if (state.rows[y]) dirty_rows |= 1u << y;
+    }
+    state.rows.fill(0);
+}
+
+// Substitui o framebuffer marcando só as linhas que mudaram
+void Display::set_rows(const std::array<uint64_t, HEIGHT>& value) {
+    for (int y = 0; y < HEIGHT; ++y) {
+        if (state.rows[y] != value[y]) dirty_rows |= 1u << y;
+    }
+    state.rows = value;
+}
+
+// Aplica XOR das máscaras em count linhas consecutivas; retorna os bits que colidiram
+uint64_t Display::xor_rows(uint64_t* dst, const uint64_t* masks, int count) {
+    uint64_t hit = 0;
+    int i = 0;
+#if CHIP8_DISPLAY_SSE2
+    // Duas linhas por registrador SSE2
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 2 <= count; i += 2) {
+        __m128i row = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks + i));
+        acc = _mm_or_si128(acc, _mm_and_si128(row, mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(row, mask));
+    }
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    hit = lanes[0] | lanes[1];
+#endif
+    for (; i < count; ++i) {
+        hit |= dst[i] & masks[i];
+        dst[i] ^= masks[i];
+    }
+    return hit;
 }
 
 // Desenha um sprite na tela na posição (x, y)
 bool Display::draw_sprite(uint8_t x, uint8_t y, const uint8_t* sprite, uint8_t n) {
-    bool collision = false;
+    // Cada byte do sprite vira uma máscara de linha; a rotação faz o wrap horizontal
+    // Linhas com máscara não nula são as únicas que o XOR altera
+    if (n == 0) return false; // DXY0 não desenha nada
+    uint64_t masks[16];
+    unsigned shift = x % WIDTH;
+    int top = y % HEIGHT;
+    uint32_t touched = 0;
     for (uint8_t row = 0; row < n; ++row) {
-        uint8_t sprite_byte = sprite[row];
-        for (uint8_t col = 0; col < 8; ++col) {
-            if ((sprite_byte & (0x80 >> col)) != 0) {
-                int px = (x + col) % WIDTH;
-                int py = (y + row) % HEIGHT;
-                int idx = py * WIDTH + px;
-                if (pixels[idx]) collision = true;
-                pixels[idx] ^= 1;
-            }
-        }
+        uint64_t bits = static_cast<uint64_t>(sprite[row]) << (WIDTH - 8);
+        masks[row] = shift ? (bits >> shift) | (bits << (WIDTH - shift)) : bits;
+        if (bits) touched |= 1u << ((top + row) % HEIGHT);
     }
-    render();
-    return collision;
-}
+    dirty_rows |= touched;
 
-// Atualiza a janela SDL com o estado atual dos pixels
-void Display::render() {
-    update_texture();
-    SDL_RenderClear(renderer);
-    SDL_RenderCopy(renderer, texture, nullptr, nullptr);
-    SDL_RenderPresent(renderer);
+    // Parte contígua até a borda inferior e a parte que dá a volta para o topo
+    int first = std::min<int>(n, HEIGHT - top);
+    uint64_t hit = xor_rows(&state.rows[top], masks, first);
+    if (first < n) hit |= xor_rows(&state.rows[0], masks + first, n - first);
+    return hit != 0;
 }
 
-// Atualiza a textura SDL com o framebuffer
-void Display::update_texture() {
-    uint32_t buffer[WIDTH * HEIGHT];
-    for (int i = 0; i < WIDTH * HEIGHT; ++i) {
-        buffer[i] = pixels[i] ? 0xFFFFFFFF : 0xFF000000; // Branco ou preto
+// Hash FNV-1a do framebuffer
+uint64_t Display::hash() const {
+    uint64_t h = 1469598103934665603ULL;
+    for (uint64_t row : state.rows) {
+        for (int byte = 0; byte < 8; ++byte) {
+            h ^= (row >> (56 - 8 * byte)) & 0xFF;
+            h *= 1099511628211ULL;
+        }
     }
-    SDL_UpdateTexture(texture, nullptr, buffer, WIDTH * sizeof(uint32_t));
+    return h;
 }
-
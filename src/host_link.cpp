@@ -0,0 +1,64 @@
+// Canal entre a thread da plataforma e a thread de emulação
+
+#include "../include/host_link.h"
+
+// Publica o estado das teclas e acumula os toques ainda não retirados
+void HostLink::post_keys(uint16_t mask, uint16_t presses, Clock::time_point when) {
+    int64_t expected = 0;
+    int64_t stamp = std::chrono::duration_cast<std::chrono::nanoseconds>(when.time_since_epoch()).count();
+    key_time.compare_exchange_strong(expected, stamp == 0 ? 1 : stamp, std::memory_order_relaxed);
+    uint64_t old = keys.load(std::memory_order_relaxed);
+    uint64_t next;
+    do {
+        uint64_t taps = ((old >> 16) & 0xFFFF) | presses;
+        next = mask | (taps << 16) | KEYS_CHANGED;
+    } while (!keys.compare_exchange_weak(old, next, std::memory_order_release, std::memory_order_relaxed));
+    notify();
+}
+
+// Retira as teclas enviadas desde a última chamada
+bool HostLink::take_keys(uint16_t& mask, uint16_t& presses, Clock::time_point& since) {
+    uint64_t old = keys.load(std::memory_order_relaxed);
+    do {
+        if (!(old & KEYS_CHANGED)) return false;
+    } while (!keys.compare_exchange_weak(old, old & 0xFFFF, std::memory_order_acquire, std::memory_order_relaxed));
+    mask = static_cast<uint16_t>(old & 0xFFFF);
+    presses = static_cast<uint16_t>((old >> 16) & 0xFFFF);
+    int64_t stamp = key_time.exchange(0, std::memory_order_relaxed);
+    since = stamp ? Clock::time_point(std::chrono::nanoseconds(stamp)) : Clock::now();
+    return true;
+}
+
+bool HostLink::post_command(HostCommand command) {
+    bool queued = commands.push(command);
+    notify();
+    return queued;
+}
+
+bool HostLink::next_command(HostCommand& command) {
+    return commands.pop(&command, 1) == 1;
+}
+
+void HostLink::set_rewind_held(bool held) {
+    if (rewind.exchange(held, std::memory_order_relaxed) != held) notify();
+}
+
+void HostLink::request_quit() {
+    quit.store(true, std::memory_order_release);
+    notify();
+}
+
+// Dorme até deadline ou até a plataforma mandar algo
+void HostLink::wait_for_host(Clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(wake_mutex);
+    wake.wait_until(lock, deadline, [this] { return wake_pending; });
+    wake_pending = false;
+}
+
+void HostLink::notify() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        wake_pending = true;
+    }
+    wake.notify_one();
+}
@@ -1,70 +1,51 @@
 // Módulo de entrada do Chip-8
-// Gerencia o teclado hexadecimal e mapeia para teclas físicas
+// Gerencia o estado do teclado hexadecimal
 
 #include "../include/input.h"
+#include "../include/trace.h"
 #include <iostream>
-#include <algorithm>
 
 // Construtor: inicializa todas as teclas como não pressionadas
-Input::Input() {
-    std::fill(std::begin(keys), std::end(keys), false);
+Input::Input(InputState& state) : state(state), event_count(0) {
+    state.keys = 0;
+    state.presses = 0;
 }
 
 Input::~Input() {}
 
-// Mapeia SDL_Keycode para índice CHIP-8
-int Input::map_key(SDL_Keycode key) const {
-    switch (key) {
-        case SDLK_1: return 0x1;
-        case SDLK_2: return 0x2;
-        case SDLK_3: return 0x3;
-        case SDLK_4: return 0xC;
-        case SDLK_q: return 0x4;
-        case SDLK_w: return 0x5;
-        case SDLK_e: return 0x6;
-        case SDLK_r: return 0xD;
-        case SDLK_a: return 0x7;
-        case SDLK_s: return 0x8;
-        case SDLK_d: return 0x9;
-        case SDLK_f: return 0xE;
-        case SDLK_z: return 0xA;
-        case SDLK_x: return 0x0;
-        case SDLK_c: return 0xB;
-        case SDLK_v: return 0xF;
-        default: return -1;
-    }
-}
-
-// Processa evento de teclado SDL
-void Input::handle_event(const SDL_Event& e) {
-    if (e.type == SDL_KEYDOWN || e.type == SDL_KEYUP) {
-        int idx = map_key(e.key.keysym.sym);
-        if (idx >= 0 && idx < 16) {
-            keys[idx] = (e.type == SDL_KEYDOWN);
-        }
+// Atualiza o estado de uma tecla Chip-8
+void Input::set_key(uint8_t key, bool pressed) {
+    if (key < 16) {
+        uint16_t bit = static_cast<uint16_t>(1u << key);
+        if (((state.keys & bit) != 0) == pressed) return;
+        state.keys ^= bit;
+        if (pressed) state.presses |= bit;
+        ++event_count;
+        return;
     }
+    std::cerr << "[Input] ERRO: Tecla inválida atualizada: " << (int)key << std::endl;
 }
 
 // Verifica se uma tecla CHIP-8 está pressionada
 bool Input::is_pressed(uint8_t key) const {
-    if (key < 16) return keys[key];
-    std::cerr << "[Input] ERRO: Tecla inválida consultada: " << (int)key << std::endl;
+    if (key < 16) return (state.keys >> key) & 1;
+    TraceRing::emit_current(TraceKind::InvalidKey, key);
     return false;
 }
 
-// Bloqueia até que o usuário pressione uma tecla válida
-uint8_t Input::wait_for_key() {
-    SDL_Event e;
-    while (true) {
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_KEYDOWN) {
-                int idx = map_key(e.key.keysym.sym);
-                if (idx >= 0 && idx < 16) {
-                    keys[idx] = true;
-                    return idx;
-                }
-            }
-        }
-        SDL_Delay(1); 
-    }
+// Estado das 16 teclas como máscara de bits
+uint16_t Input::get_key_mask() const {
+    return state.keys;
+}
+
+void Input::set_key_mask(uint16_t mask) {
+    state.keys = mask;
+    state.presses = 0;
+}
+
+// Retira as teclas pressionadas desde a última chamada
+uint16_t Input::take_presses() {
+    uint16_t taken = state.presses;
+    state.presses = 0;
+    return taken;
 }
@@ -0,0 +1,66 @@
+// Script de entrada do Chip-8
+// Leitura do formato texto "<quadro> <tecla> <down|up>"
+
+#include "../include/input_script.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// Lê o script de um arquivo
+bool InputScript::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[InputScript] ERRO: Não foi possível abrir o script: " << path << std::endl;
+        return false;
+    }
+    return read(file, path);
+}
+
+// Lê eventos de um fluxo até o fim
+bool InputScript::read(std::istream& in, const std::string& name, int first_line) {
+    events.clear();
+    std::string line;
+    int line_number = first_line - 1;
+    while (std::getline(in, line)) {
+        ++line_number;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string frame_text, key_text, state;
+        if (!(fields >> frame_text)) continue; // Linha vazia ou só comentário
+
+        Event event{};
+        try {
+            if (!(fields >> key_text >> state)) throw std::invalid_argument("campos");
+            event.frame = std::stoull(frame_text);
+            unsigned long key = std::stoul(key_text, nullptr, 16);
+            if (key > 0xF) throw std::out_of_range("tecla");
+            event.key = static_cast<uint8_t>(key);
+            if (state == "down") {
+                event.pressed = true;
+            } else if (state == "up") {
+                event.pressed = false;
+            } else {
+                throw std::invalid_argument("estado");
+            }
+        } catch (...) {
+            std::cerr << "[InputScript] ERRO: Linha inválida em " << name << ":" << line_number
+                      << " (use: <quadro> <tecla 0-F> <down|up>)" << std::endl;
+            return false;
+        }
+        events.push_back(event);
+    }
+
+    // Mantém a ordem do arquivo entre eventos do mesmo quadro
+    std::stable_sort(events.begin(), events.end(),
+                     [](const Event& a, const Event& b) { return a.frame < b.frame; });
+    return true;
+}
+
+// Grava os eventos no mesmo formato texto
+void InputScript::write(std::ostream& out) const {
+    for (const Event& event : events) {
+        out << event.frame << ' ' << std::hex << std::uppercase << static_cast<int>(event.key)
+            << std::dec << std::nouppercase << ' ' << (event.pressed ? "down" : "up") << '\n';
+    }
+}
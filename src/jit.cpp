@@ -0,0 +1,493 @@
+// Recompilador dinâmico (JIT) do Chip-8 para x86-64
+// Cada bloco é uma sequência linear de opcodes terminada em desvio. ALU, I e timers viram
+// código nativo; as demais instruções chamam o handler do interpretador de dentro do bloco.
+// Instruções que mudam o PC de forma dinâmica (CALL, RET, BNNN, teclas) ou escrevem na
+// memória (FX33, FX55) encerram o bloco com uma saída indireta pela entry_table.
+//
+// Convenção dos blocos gerados:
+//   r11 = &V[0], r10 = &I, r9d = ciclos restantes
+//   eax = próximo PC ao sair pela rotina de saída
+
+#include "../include/jit.h"
+#include "../include/cpu.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CHIP8_JIT_X64 1
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#endif
+
+namespace {
+
+// Instruções traduzidas dentro do corpo do bloco
+bool is_body_opcode(uint16_t opcode) {
+    switch (opcode & 0xF000) {
+        case 0x6000: case 0x7000: case 0xA000: return true;
+        case 0x8000:
+            switch (opcode & 0x000F) {
+                case 0x0: case 0x1: case 0x2: case 0x3: case 0x4:
+                case 0x5: case 0x6: case 0x7: case 0xE: return true;
+                default: return false;
+            }
+        case 0xF000:
+            switch (opcode & 0x00FF) {
+                case 0x07: case 0x15: case 0x18: case 0x1E: case 0x29: return true;
+                default: return false;
+            }
+        default: return false;
+    }
+}
+
+// Desvios traduzidos que encerram o bloco
+bool is_terminator_opcode(uint16_t opcode) {
+    switch (opcode & 0xF000) {
+        case 0x1000: case 0x3000: case 0x4000: case 0x5000: case 0x9000: return true;
+        default: return false;
+    }
+}
+
+// Instruções delegadas ao interpretador que encerram o bloco (PC dinâmico ou escrita na memória)
+bool is_helper_exit(Op op) {
+    switch (op) {
+        case Op::RET: case Op::CALL: case Op::JP_V0: case Op::SKP: case Op::SKNP:
+        case Op::LD_B: case Op::LD_MEM_VX: return true;
+        default: return false;
+    }
+}
+
+}
+
+// Cria o JIT e reserva a memória executável
+Jit::Jit(CPU& cpu) : cpu(cpu), code_buffer(nullptr), cursor(nullptr), entry(nullptr), exit_stub(nullptr) {
+#if CHIP8_JIT_X64
+#if defined(_WIN32)
+    void* mem = VirtualAlloc(nullptr, CODE_BUFFER_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+#else
+    void* mem = mmap(nullptr, CODE_BUFFER_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) mem = nullptr;
+#endif
+    if (!mem) {
+        std::cerr << "[JIT] ERRO: Não foi possível alocar memória executável" << std::endl;
+        throw std::runtime_error("Falha ao alocar memória do JIT");
+    }
+    code_buffer = static_cast<uint8_t*>(mem);
+    flush();
+#else
+    throw std::runtime_error("JIT não suportado neste host");
+#endif
+}
+
+// Libera a memória executável
+Jit::~Jit() {
+#if CHIP8_JIT_X64
+#if defined(_WIN32)
+    if (code_buffer) VirtualFree(code_buffer, 0, MEM_RELEASE);
+#else
+    if (code_buffer) munmap(code_buffer, CODE_BUFFER_SIZE);
+#endif
+#endif
+}
+
+// Indica se o host suporta o JIT
+bool Jit::is_supported() {
+#if CHIP8_JIT_X64
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Jit::emit16(uint16_t value) {
+    std::memcpy(cursor, &value, sizeof(value));
+    cursor += sizeof(value);
+}
+
+void Jit::emit32(uint32_t value) {
+    std::memcpy(cursor, &value, sizeof(value));
+    cursor += sizeof(value);
+}
+
+void Jit::emit64(uint64_t value) {
+    std::memcpy(cursor, &value, sizeof(value));
+    cursor += sizeof(value);
+}
+
+// Aponta um salto rel32 para dest
+void Jit::patch(uint8_t* site, const uint8_t* dest) {
+    int32_t rel = static_cast<int32_t>(dest - (site + 4));
+    std::memcpy(site, &rel, sizeof(rel));
+}
+
+// Descarta todos os blocos compilados
+void Jit::flush() {
+    for (auto& block : blocks) block = Block();
+    for (auto& sites : pending) sites.clear();
+    coverage.fill(0);
+    cursor = code_buffer;
+    emit_stubs();
+    entry_table.fill(exit_stub);
+}
+
+// Emite as rotinas de entrada e saída no início do buffer
+void Jit::emit_stubs() {
+    // Entrada: uint64_t entry(const uint8_t* code, uint32_t budget)
+    entry = reinterpret_cast<EntryFn>(cursor);
+    emit8(0x49); emit8(0xBB); emit64(reinterpret_cast<uint64_t>(cpu.state.V.data()));   // mov r11, &V
+    emit8(0x49); emit8(0xBA); emit64(reinterpret_cast<uint64_t>(&cpu.state.I));         // mov r10, &I
+#if defined(_WIN32)
+    emit8(0x41); emit8(0x89); emit8(0xD1);                                         // mov r9d, edx
+    emit8(0xFF); emit8(0xE1);                                                      // jmp rcx
+#else
+    emit8(0x41); emit8(0x89); emit8(0xF1);                                         // mov r9d, esi
+    emit8(0xFF); emit8(0xE7);                                                      // jmp rdi
+#endif
+
+    // Saída: retorna (ciclos restantes << 32) | PC
+    exit_stub = cursor;
+    emit8(0x44); emit8(0x89); emit8(0xCA);                                         // mov edx, r9d
+    emit8(0x48); emit8(0xC1); emit8(0xE2); emit8(0x20);                            // shl rdx, 32
+    emit8(0x48); emit8(0x09); emit8(0xD0);                                         // or rax, rdx
+    emit8(0xC3);                                                                   // ret
+}
+
+// Emite uma saída para target e a encadeia se o destino já estiver compilado
+void Jit::emit_exit(uint16_t target) {
+    emit8(0xB8); emit32(target);                                                   // mov eax, target
+    emit8(0xE9);                                                                   // jmp rel32
+    uint8_t* site = cursor;
+    emit32(0);
+    patch(site, exit_stub);
+
+    if (target >= Memory::MEMORY_SIZE) return;
+    Block& dest = blocks[target];
+    if (dest.state == BlockState::Compiled) {
+        patch(site, dest.code);
+        dest.incoming.push_back(site);
+    } else {
+        pending[target].push_back(site);
+    }
+}
+
+// Emite uma saída para o PC atual da CPU, via entry_table
+void Jit::emit_dynamic_exit() {
+    emit8(0x48); emit8(0xB9); emit64(reinterpret_cast<uint64_t>(&cpu.state.PC));           // mov rcx, &PC
+    emit8(0x0F); emit8(0xB7); emit8(0x01);                                         // movzx eax, word [rcx]
+    emit8(0x3D); emit32(Memory::MEMORY_SIZE);                                      // cmp eax, MEMORY_SIZE
+    emit8(0x0F); emit8(0x83); emit32(0);                                           // jae exit_stub
+    patch(cursor - 4, exit_stub);
+    emit8(0x48); emit8(0xB9); emit64(reinterpret_cast<uint64_t>(entry_table.data()));  // mov rcx, entry_table
+    emit8(0x48); emit8(0x8B); emit8(0x0C); emit8(0xC1);                            // mov rcx, [rcx + rax*8]
+    emit8(0xFF); emit8(0xE1);                                                      // jmp rcx
+}
+
+// Emite a chamada ao handler do interpretador para a instrução em pc
+void Jit::emit_helper_call(uint16_t pc, uint16_t opcode) {
+    CPU::DecodedInstruction& args = helper_args[pc];
+    args = CPU::decode(opcode);
+
+    // O handler enxerga o PC já avançado, como no interpretador
+    emit8(0x48); emit8(0xB8); emit64(reinterpret_cast<uint64_t>(&cpu.state.PC));           // mov rax, &PC
+    emit8(0x66); emit8(0xC7); emit8(0x00); emit16(static_cast<uint16_t>(pc + 2));   // mov word [rax], pc + 2
+
+    // Preserva o estado do bloco (três pushes também alinham a pilha em 16 bytes)
+    emit8(0x41); emit8(0x51);                                                      // push r9
+    emit8(0x41); emit8(0x52);                                                      // push r10
+    emit8(0x41); emit8(0x53);                                                      // push r11
+#if defined(_WIN32)
+    emit8(0x48); emit8(0x83); emit8(0xEC); emit8(0x20);                            // sub rsp, 32 (shadow space)
+    emit8(0x48); emit8(0xB9); emit64(reinterpret_cast<uint64_t>(&cpu));            // mov rcx, &cpu
+    emit8(0x48); emit8(0xBA); emit64(reinterpret_cast<uint64_t>(&args));           // mov rdx, &args
+#else
+    emit8(0x48); emit8(0xBF); emit64(reinterpret_cast<uint64_t>(&cpu));            // mov rdi, &cpu
+    emit8(0x48); emit8(0xBE); emit64(reinterpret_cast<uint64_t>(&args));           // mov rsi, &args
+#endif
+    emit8(0x48); emit8(0xB8); emit64(reinterpret_cast<uint64_t>(args.handler));    // mov rax, handler
+    emit8(0xFF); emit8(0xD0);                                                      // call rax
+#if defined(_WIN32)
+    emit8(0x48); emit8(0x83); emit8(0xC4); emit8(0x20);                            // add rsp, 32
+#endif
+    emit8(0x41); emit8(0x5B);                                                      // pop r11
+    emit8(0x41); emit8(0x5A);                                                      // pop r10
+    emit8(0x41); emit8(0x59);                                                      // pop r9
+}
+
+// Emite a verificação de laço ocioso antes do JP para target (desconta do orçamento os ciclos pulados)
+void Jit::emit_idle_skip(uint16_t target) {
+    emit8(0x48); emit8(0xB8); emit64(reinterpret_cast<uint64_t>(&cpu.state.PC));           // mov rax, &PC
+    emit8(0x66); emit8(0xC7); emit8(0x00); emit16(target);                          // mov word [rax], target
+
+    emit8(0x41); emit8(0x51);                                                      // push r9
+    emit8(0x41); emit8(0x52);                                                      // push r10
+    emit8(0x41); emit8(0x53);                                                      // push r11
+#if defined(_WIN32)
+    emit8(0x48); emit8(0x83); emit8(0xEC); emit8(0x20);                            // sub rsp, 32 (shadow space)
+    emit8(0x48); emit8(0xB9); emit64(reinterpret_cast<uint64_t>(&cpu));            // mov rcx, &cpu
+    emit8(0x44); emit8(0x89); emit8(0xCA);                                         // mov edx, r9d
+#else
+    emit8(0x48); emit8(0xBF); emit64(reinterpret_cast<uint64_t>(&cpu));            // mov rdi, &cpu
+    emit8(0x44); emit8(0x89); emit8(0xCE);                                         // mov esi, r9d
+#endif
+    emit8(0x48); emit8(0xB8); emit64(reinterpret_cast<uint64_t>(&CPU::skip_idle_loop_helper));  // mov rax, helper
+    emit8(0xFF); emit8(0xD0);                                                      // call rax
+#if defined(_WIN32)
+    emit8(0x48); emit8(0x83); emit8(0xC4); emit8(0x20);                            // add rsp, 32
+#endif
+    emit8(0x41); emit8(0x5B);                                                      // pop r11
+    emit8(0x41); emit8(0x5A);                                                      // pop r10
+    emit8(0x41); emit8(0x59);                                                      // pop r9
+    emit8(0x41); emit8(0x29); emit8(0xC1);                                         // sub r9d, eax
+}
+
+// Compila o bloco que começa em pc
+bool Jit::compile(uint16_t pc) {
+    // Varredura: coleta as instruções do bloco
+    uint16_t opcodes[MAX_BLOCK_INSTRUCTIONS];
+    int count = 0;
+    bool terminated = false;
+    uint32_t p = pc;
+    while (count < MAX_BLOCK_INSTRUCTIONS && p + 1 < Memory::MEMORY_SIZE) {
+        uint16_t opcode = (cpu.memory.read(p) << 8) | cpu.memory.read(p + 1);
+        // FX0A fica com o interpretador: o estado de espera precisa devolver o controle a run
+        if (OPCODE_TABLE[opcode] == Op::LD_VX_K) break;
+        opcodes[count++] = opcode;
+        p += 2;
+        if (is_terminator_opcode(opcode) || is_helper_exit(OPCODE_TABLE[opcode])) {
+            terminated = true;
+            break;
+        }
+    }
+    if (count == 0) return false;
+
+    if (cursor + MAX_BLOCK_CODE > code_buffer + CODE_BUFFER_SIZE) flush();
+
+    Block& block = blocks[pc];
+    block.code = cursor;
+    block.end = static_cast<uint16_t>(p);
+
+    auto load_eax = [&](uint8_t r) { emit8(0x41); emit8(0x0F); emit8(0xB6); emit8(0x43); emit8(r); };  // movzx eax, byte [r11+r]
+    auto load_ecx = [&](uint8_t r) { emit8(0x41); emit8(0x0F); emit8(0xB6); emit8(0x4B); emit8(r); };  // movzx ecx, byte [r11+r]
+    auto store_al = [&](uint8_t r) { emit8(0x41); emit8(0x88); emit8(0x43); emit8(r); };               // mov [r11+r], al
+    auto store_dl = [&](uint8_t r) { emit8(0x41); emit8(0x88); emit8(0x53); emit8(r); };               // mov [r11+r], dl
+    auto seta_dl = [&]() { emit8(0x0F); emit8(0x97); emit8(0xC2); };                                    // seta dl
+    auto cmp_al_cl = [&]() { emit8(0x38); emit8(0xC8); };                                                // cmp al, cl
+
+    // Verifica o orçamento de ciclos antes de executar o bloco
+    emit8(0x41); emit8(0x81); emit8(0xF9); emit32(count);                          // cmp r9d, count
+    emit8(0x0F); emit8(0x82);                                                      // jb bail
+    uint8_t* bail_site = cursor;
+    emit32(0);
+    emit8(0x41); emit8(0x81); emit8(0xE9); emit32(count);                          // sub r9d, count
+
+    for (int i = 0; i < count; ++i) {
+        uint16_t opcode = opcodes[i];
+        uint16_t next = static_cast<uint16_t>(pc + 2 * (i + 1));
+        uint8_t x = (opcode & 0x0F00) >> 8;
+        uint8_t y = (opcode & 0x00F0) >> 4;
+        uint8_t kk = opcode & 0x00FF;
+        uint16_t nnn = opcode & 0x0FFF;
+
+        // Instruções com E/S ou fluxo dinâmico: handler do interpretador
+        if (!is_body_opcode(opcode) && !is_terminator_opcode(opcode)) {
+            uint16_t at = static_cast<uint16_t>(pc + 2 * i);
+            emit_helper_call(at, opcode);
+            if (is_helper_exit(OPCODE_TABLE[opcode])) emit_dynamic_exit();
+            continue;
+        }
+
+        switch (opcode & 0xF000) {
+            case 0x1000: // 1NNN: JP addr
+                if (cpu.idle_skip && cpu.is_idle_loop_candidate(static_cast<uint16_t>(pc + 2 * i), nnn)) {
+                    emit_idle_skip(nnn);
+                }
+                emit_exit(nnn);
+                break;
+            case 0x3000: // 3XKK: SE Vx, byte
+            case 0x4000: // 4XKK: SNE Vx, byte
+            case 0x5000: // 5XY0: SE Vx, Vy
+            case 0x9000: { // 9XY0: SNE Vx, Vy
+                if ((opcode & 0xF000) == 0x3000 || (opcode & 0xF000) == 0x4000) {
+                    emit8(0x41); emit8(0x80); emit8(0x7B); emit8(x); emit8(kk);    // cmp byte [r11+x], kk
+                } else {
+                    load_ecx(x);
+                    emit8(0x41); emit8(0x3A); emit8(0x4B); emit8(y);               // cmp cl, [r11+y]
+                }
+                bool skip_if_equal = (opcode & 0xF000) == 0x3000 || (opcode & 0xF000) == 0x5000;
+                emit8(0x0F); emit8(skip_if_equal ? 0x85 : 0x84);                   // jne/je no_skip
+                uint8_t* no_skip = cursor;
+                emit32(0);
+                emit_exit(static_cast<uint16_t>(next + 2));
+                patch(no_skip, cursor);
+                emit_exit(next);
+                break;
+            }
+            case 0x6000: // 6XKK: LD Vx, byte
+                emit8(0x41); emit8(0xC6); emit8(0x43); emit8(x); emit8(kk);        // mov byte [r11+x], kk
+                break;
+            case 0x7000: // 7XKK: ADD Vx, byte
+                emit8(0x41); emit8(0x80); emit8(0x43); emit8(x); emit8(kk);        // add byte [r11+x], kk
+                break;
+            case 0x8000:
+                switch (opcode & 0x000F) {
+                    case 0x0: // 8XY0: LD Vx, Vy
+                        load_eax(y); store_al(x);
+                        break;
+                    case 0x1: // 8XY1: OR Vx, Vy
+                        load_eax(x); load_ecx(y); emit8(0x08); emit8(0xC8); store_al(x);
+                        break;
+                    case 0x2: // 8XY2: AND Vx, Vy
+                        load_eax(x); load_ecx(y); emit8(0x20); emit8(0xC8); store_al(x);
+                        break;
+                    case 0x3: // 8XY3: XOR Vx, Vy
+                        load_eax(x); load_ecx(y); emit8(0x30); emit8(0xC8); store_al(x);
+                        break;
+                    case 0x4: // 8XY4: ADD Vx, Vy
+                        load_eax(x); load_ecx(y);
+                        emit8(0x01); emit8(0xC8);                                  // add eax, ecx
+                        emit8(0x3D); emit32(0xFF);                                 // cmp eax, 0xFF
+                        seta_dl(); store_dl(0xF); store_al(x);
+                        break;
+                    case 0x5: // 8XY5: SUB Vx, Vy
+                        load_eax(x); load_ecx(y); cmp_al_cl(); seta_dl(); store_dl(0xF);
+                        load_eax(x); load_ecx(y); emit8(0x28); emit8(0xC8); store_al(x);
+                        break;
+                    case 0x6: // 8XY6: SHR Vx
+                        load_eax(x); emit8(0x24); emit8(0x01); store_al(0xF);      // and al, 1
+                        load_eax(x); emit8(0xD0); emit8(0xE8); store_al(x);        // shr al, 1
+                        break;
+                    case 0x7: // 8XY7: SUBN Vx, Vy
+                        load_eax(y); load_ecx(x); cmp_al_cl(); seta_dl(); store_dl(0xF);
+                        load_eax(y); load_ecx(x); emit8(0x28); emit8(0xC8); store_al(x);
+                        break;
+                    case 0xE: // 8XYE: SHL Vx
+                        load_eax(x); emit8(0xC0); emit8(0xE8); emit8(0x07); store_al(0xF);  // shr al, 7
+                        load_eax(x); emit8(0x00); emit8(0xC0); store_al(x);                 // add al, al
+                        break;
+                }
+                break;
+            case 0xA000: // ANNN: LD I, addr
+                emit8(0x66); emit8(0x41); emit8(0xC7); emit8(0x02); emit16(nnn);   // mov word [r10], nnn
+                break;
+            case 0xF000:
+                switch (kk) {
+                    case 0x07: // FX07: LD Vx, DT
+                        emit8(0x48); emit8(0xB8); emit64(reinterpret_cast<uint64_t>(&cpu.state.delay_timer)); // mov rax, &DT
+                        emit8(0x0F); emit8(0xB6); emit8(0x00);                                          // movzx eax, byte [rax]
+                        store_al(x);
+                        break;
+                    case 0x15: // FX15: LD DT, Vx
+                    case 0x18: { // FX18: LD ST, Vx
+                        uint8_t* timer = (kk == 0x15) ? &cpu.state.delay_timer : &cpu.state.sound_timer;
+                        load_eax(x);
+                        emit8(0x48); emit8(0xB9); emit64(reinterpret_cast<uint64_t>(timer));          // mov rcx, &timer
+                        emit8(0x88); emit8(0x01);                                                       // mov [rcx], al
+                        break;
+                    }
+                    case 0x1E: // FX1E: ADD I, Vx
+                        load_eax(x);
+                        emit8(0x66); emit8(0x41); emit8(0x01); emit8(0x02);        // add word [r10], ax
+                        break;
+                    case 0x29: // FX29: LD F, Vx
+                        load_eax(x);
+                        emit8(0x83); emit8(0xE0); emit8(0x0F);                     // and eax, 0xF
+                        emit8(0x8D); emit8(0x04); emit8(0x80);                     // lea eax, [rax + rax*4]
+                        emit8(0x05); emit32(Memory::FONT_START);                   // add eax, FONT_START
+                        emit8(0x66); emit8(0x41); emit8(0x89); emit8(0x02);        // mov word [r10], ax
+                        break;
+                }
+                break;
+        }
+    }
+    if (!terminated) emit_exit(static_cast<uint16_t>(p));
+
+    // Orçamento insuficiente: devolve o controle sem executar nada
+    patch(bail_site, cursor);
+    emit8(0xB8); emit32(pc);                                                       // mov eax, pc
+    emit8(0xE9); emit32(0);                                                        // jmp exit_stub
+    patch(cursor - 4, exit_stub);
+
+    // Registra o bloco e encadeia as saídas que esperavam por ele
+    block.state = BlockState::Compiled;
+    entry_table[pc] = block.code;
+    for (uint32_t a = pc; a < p; ++a) ++coverage[a];
+    for (uint8_t* site : pending[pc]) {
+        patch(site, block.code);
+        block.incoming.push_back(site);
+    }
+    pending[pc].clear();
+    return true;
+}
+
+// Descarta um único bloco
+void Jit::drop_block(uint16_t pc, bool counted) {
+    Block& block = blocks[pc];
+    for (uint8_t* site : block.incoming) {
+        patch(site, exit_stub);
+        pending[pc].push_back(site);
+    }
+    block.incoming.clear();
+    entry_table[pc] = exit_stub;
+    for (uint32_t a = pc; a < block.end; ++a) --coverage[a];
+    block.state = BlockState::Empty;
+    block.code = nullptr;
+    if (counted && block.invalidations < MAX_INVALIDATIONS) ++block.invalidations;
+}
+
+// Descarta os blocos que cobrem [address, address + length)
+void Jit::invalidate(uint16_t address, uint16_t length, bool counted) {
+    uint32_t last = std::min<uint32_t>(uint32_t(address) + length, Memory::MEMORY_SIZE);
+    for (uint32_t a = address; a < last; ++a) {
+        // Blocos que começam aqui ou no byte anterior podem ter sido marcados como não traduzíveis
+        for (uint32_t s = (a > 0 ? a - 1 : 0); s <= a; ++s) {
+            Block& block = blocks[s];
+            if (block.state == BlockState::Interpret && block.invalidations < MAX_INVALIDATIONS) {
+                block.state = BlockState::Empty;
+            }
+        }
+        if (coverage[a] == 0) continue;
+        uint32_t first = a >= 2 * MAX_BLOCK_INSTRUCTIONS ? a - 2 * MAX_BLOCK_INSTRUCTIONS + 1 : 0;
+        for (uint32_t s = first; s <= a; ++s) {
+            if (blocks[s].state == BlockState::Compiled && blocks[s].end > a) drop_block(static_cast<uint16_t>(s), counted);
+        }
+    }
+}
+
+// Blocos marcados para o interpretador
+int Jit::interpreted_blocks() const {
+    int count = 0;
+    for (const Block& block : blocks) count += block.state == BlockState::Interpret;
+    return count;
+}
+
+// Executa até max_cycles instruções; retorna quantas foram executadas
+int Jit::run(int max_cycles) {
+    int executed = 0;
+    while (executed < max_cycles) {
+        uint16_t pc = cpu.state.PC;
+        if (pc + 1 < Memory::MEMORY_SIZE) {
+            Block& block = blocks[pc];
+            if (block.state == BlockState::Empty) {
+                if (block.invalidations >= MAX_INVALIDATIONS || !compile(pc)) block.state = BlockState::Interpret;
+            }
+            if (block.state == BlockState::Compiled) {
+                uint64_t result = entry(block.code, static_cast<uint32_t>(max_cycles - executed));
+                cpu.state.PC = static_cast<uint16_t>(result & 0xFFFF);
+                int remaining = static_cast<int>(result >> 32);
+                if (max_cycles - remaining > executed) {
+                    executed = max_cycles - remaining;
+                    continue;
+                }
+                // Orçamento menor que o bloco: segue instrução por instrução
+            }
+        }
+        cpu.emulate_cycle();
+        ++executed;
+        if (cpu.state.key_wait_reg >= 0) return executed + cpu.idle_key_wait(max_cycles - executed);
+    }
+    return executed;
+}
@@ -0,0 +1,591 @@
+// Interpretador em lockstep: até LANES instâncias da mesma ROM em lanes SIMD
+// Cada caso do switch é a versão vetorial do exec<K> correspondente em cpu.cpp
+
+#include "../include/lockstep.h"
+#include "../include/opcodes.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CHIP8_LOCKSTEP_SSE2 1
+#endif
+
+namespace {
+constexpr uint16_t ADDRESS_MASK = Config::Memory::SIZE - 1;
+constexpr uint32_t RNG_ZERO_SEED = 0x9E3779B9u; // Substituto da semente 0 (ver Rng)
+}
+
+// Cria as lanes zeradas, sem espera de FX0A
+LockstepGroup::LockstepGroup(int lanes, int ipf) : lanes(lanes), ipf(ipf), regs{} {
+    if (lanes < 1 || lanes > LANES) throw std::invalid_argument("número de lanes fora de 1 a 16");
+    if (ipf <= 0) throw std::invalid_argument("instruções por quadro precisam ser positivas");
+    used = (1u << lanes) - 1;
+    lane.resize(lanes);
+    displays.reserve(lanes);
+    for (int l = 0; l < lanes; ++l) {
+        lane[l].stack.fill(0);
+        lane[l].key_wait_reg = -1;
+        lane[l].key_wait_held = 0;
+        lane[l].key_wait_pressed = 0;
+        lane[l].ram.fill(0);
+        displays.emplace_back(screens[l]);
+    }
+}
+
+// Copia uma máquina para a lane
+void LockstepGroup::load_lane(int l, const MachineState& state) {
+    const CpuState& cpu = state.cpu;
+    for (int r = 0; r < 16; ++r) regs.V[r][l] = cpu.V[r];
+    regs.I[l] = cpu.I;
+    regs.PC[l] = cpu.PC;
+    regs.SP[l] = cpu.SP;
+    regs.delay_timer[l] = cpu.delay_timer;
+    regs.sound_timer[l] = cpu.sound_timer;
+    regs.rng[l] = cpu.rng_state ? cpu.rng_state : RNG_ZERO_SEED;
+    regs.keys[l] = state.input.keys;
+    regs.presses[l] = state.input.presses;
+    lane[l].stack = cpu.stack;
+    lane[l].key_wait_reg = cpu.key_wait_reg;
+    lane[l].key_wait_held = cpu.key_wait_held;
+    lane[l].key_wait_pressed = cpu.key_wait_pressed;
+    lane[l].ram = state.ram;
+    displays[l].set_rows(state.display.rows);
+    blocks_stale = true;
+}
+
+// Copia o estado da lane para out
+void LockstepGroup::save_lane(int l, MachineState& out) const {
+    CpuState& cpu = out.cpu;
+    std::memset(&cpu, 0, sizeof(cpu)); // Preenchimento zerado, como no estado de um Chip8
+    for (int r = 0; r < 16; ++r) cpu.V[r] = regs.V[r][l];
+    cpu.I = regs.I[l];
+    cpu.PC = regs.PC[l];
+    cpu.SP = regs.SP[l];
+    cpu.stack = lane[l].stack;
+    cpu.delay_timer = regs.delay_timer[l];
+    cpu.sound_timer = regs.sound_timer[l];
+    cpu.rng_state = regs.rng[l];
+    cpu.key_wait_held = lane[l].key_wait_held;
+    cpu.key_wait_pressed = lane[l].key_wait_pressed;
+    cpu.key_wait_reg = lane[l].key_wait_reg;
+    out.input.keys = regs.keys[l];
+    out.input.presses = regs.presses[l];
+    out.display = screens[l];
+    out.ram = lane[l].ram;
+}
+
+// Pressiona ou solta uma tecla na lane
+void LockstepGroup::set_key(int l, uint8_t key, bool pressed) {
+    if (key >= 16) return;
+    uint16_t bit = static_cast<uint16_t>(1u << key);
+    if (((regs.keys[l] & bit) != 0) == pressed) return;
+    regs.keys[l] ^= bit;
+    if (pressed) regs.presses[l] |= bit;
+}
+
+// Teclas da lane, reproduzindo os toques
+void LockstepGroup::apply_keys(int l, uint16_t mask, uint16_t presses) {
+    for (uint8_t key = 0; key < 16; ++key) {
+        bool down = (mask >> key) & 1;
+        if ((presses >> key) & 1) {
+            set_key(l, key, false);
+            set_key(l, key, true);
+        }
+        set_key(l, key, down);
+    }
+}
+
+// Bits das lanes com o byte de máscara ligado
+uint32_t LockstepGroup::lane_bits(Mask8 m) {
+#if CHIP8_LOCKSTEP_SSE2
+    static_assert(LANES == 16, "uma máscara de lanes por registrador SSE2");
+    return static_cast<uint32_t>(_mm_movemask_epi8(reinterpret_cast<__m128i>(m)));
+#else
+    uint32_t bits = 0;
+    for (int l = 0; l < LANES; ++l) bits |= (m[l] ? 1u : 0u) << l;
+    return bits;
+#endif
+}
+
+// Máscara com os bytes das lanes de bits ligados
+LockstepGroup::Mask8 LockstepGroup::lane_mask(uint32_t bits) {
+    // Byte l recebe o byte de bits da sua lane e testa o bit l % 8
+    static_assert(LANES == 16, "dois bytes de bits por máscara");
+    uint8_t low = bits & 0xFF;
+    uint8_t high = (bits >> 8) & 0xFF;
+    Lanes8 spread = {low, low, low, low, low, low, low, low, high, high, high, high, high, high, high, high};
+    const Lanes8 lane_bit = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    return (spread & lane_bit) != 0;
+}
+
+// Recalcula os blocos de RAM que diferem entre as lanes
+void LockstepGroup::refresh_blocks() {
+    diverged_blocks = 0;
+    for (int l = 1; l < lanes; ++l) {
+        for (int b = 0; b < Config::Memory::SIZE / CODE_BLOCK; ++b) {
+            if (std::memcmp(&lane[l].ram[b * CODE_BLOCK], &lane[0].ram[b * CODE_BLOCK], CODE_BLOCK) != 0) {
+                diverged_blocks |= 1ull << b;
+            }
+        }
+    }
+    blocks_stale = false;
+}
+
+// Escrita de length bytes em I nas lanes de group
+void LockstepGroup::track_write(uint32_t group, bool same_bytes, int length) {
+    // Mesmos bytes no mesmo endereço em todas as lanes: a RAM continua igual entre elas
+    if (same_bytes && group == used) {
+        bool same_address = true;
+        for (int l = 1; l < lanes; ++l) same_address &= regs.I[l] == regs.I[0];
+        if (same_address) return;
+    }
+    for (uint32_t bits = group; bits; bits &= bits - 1) {
+        int l = __builtin_ctz(bits);
+        uint16_t first = regs.I[l] & ADDRESS_MASK;
+        uint16_t last = (regs.I[l] + length - 1) & ADDRESS_MASK;
+        diverged_blocks |= (1ull << (first / CODE_BLOCK)) | (1ull << (last / CODE_BLOCK));
+    }
+}
+
+// Executa um quadro em todas as lanes
+int LockstepGroup::run_frame() {
+    if (blocks_stale) refresh_blocks();
+    // FX0A pendente: como em CPU::run, sem tecla solta a lane passa o quadro inteiro em espera
+    for (int l = 0; l < lanes; ++l) {
+        if (lane[l].key_wait_reg >= 0) resolve_key_wait(l);
+    }
+    // Os contadores por lane têm 16 bits: quadros maiores rodam em partes
+    for (int left = ipf; left > 0;) {
+        int budget = std::min(left, 0xFFFF);
+        run_budget(static_cast<uint16_t>(budget));
+        left -= budget;
+    }
+    // Fim do quadro: toques descartados e tick dos timers
+    regs.presses.fill(0);
+    regs.delay_timer = regs.delay_timer != 0 ? regs.delay_timer - 1 : regs.delay_timer;
+    regs.sound_timer = regs.sound_timer != 0 ? regs.sound_timer - 1 : regs.sound_timer;
+    return ipf;
+}
+
+// Confere a espera do FX0A da lane contra as teclas atuais
+bool LockstepGroup::resolve_key_wait(int l) {
+    Lane& s = lane[l];
+    uint16_t mask = regs.keys[l];
+    uint16_t presses = regs.presses[l];
+    regs.presses[l] = 0;
+    // Teclas seguradas desde a entrada só contam depois de soltas e pressionadas de novo
+    s.key_wait_held &= mask & ~presses;
+    s.key_wait_pressed |= (mask | presses) & ~s.key_wait_held;
+    uint16_t released = s.key_wait_pressed & ~mask;
+    if (!released) return false;
+    regs.V[s.key_wait_reg][l] = static_cast<uint8_t>(__builtin_ctz(released));
+    s.key_wait_reg = -1;
+    s.key_wait_pressed = 0;
+    regs.PC[l] += 2;
+    return true;
+}
+
+namespace {
+// Instruções do corpo de um laço ocioso (as mesmas de CPU::is_idle_loop_candidate)
+bool is_idle_loop_op(Op op) {
+    switch (op) {
+        case Op::JP: case Op::SE_BYTE: case Op::SNE_BYTE: case Op::SE_REG: case Op::SNE_REG:
+        case Op::SKP: case Op::SKNP: case Op::LD_VX_DT: case Op::LD_BYTE: return true;
+        default: return false;
+    }
+}
+}
+
+// Indica se o JP em pc para target fecha um laço candidato a ocioso na lane l
+bool LockstepGroup::is_idle_loop_candidate(int l, uint16_t pc, uint16_t target) const {
+    if (target > pc || (pc - target) / 2 >= Config::CPU::MAX_IDLE_LOOP) return false;
+    for (uint16_t a = target; a < pc; a += 2) {
+        if (!is_idle_loop_op(OPCODE_TABLE[read_opcode(l, a)])) return false;
+    }
+    return true;
+}
+
+// Simula uma iteração do laço da lane l em uma cópia de V (como CPU::skip_idle_loop)
+int LockstepGroup::skip_idle_loop(int l, uint16_t loop_pc, int remaining) const {
+    std::array<uint8_t, 16> start;
+    for (int r = 0; r < 16; ++r) start[r] = regs.V[r][l];
+    std::array<uint8_t, 16> v = start;
+    uint16_t pc = loop_pc;
+    uint16_t keys = regs.keys[l];
+    for (int steps = 1; steps <= Config::CPU::MAX_IDLE_LOOP && pc < Config::Memory::SIZE - 1; ++steps) {
+        uint16_t opcode = read_opcode(l, pc);
+        uint8_t x = (opcode & 0x0F00) >> 8;
+        uint8_t y = (opcode & 0x00F0) >> 4;
+        uint8_t kk = opcode & 0x00FF;
+        pc += 2;
+        switch (OPCODE_TABLE[opcode]) {
+            case Op::JP:
+                if ((opcode & 0x0FFF) != loop_pc || v != start) return 0;
+                return remaining / steps * steps;
+            case Op::SE_BYTE: if (v[x] == kk) pc += 2; break;
+            case Op::SNE_BYTE: if (v[x] != kk) pc += 2; break;
+            case Op::SE_REG: if (v[x] == v[y]) pc += 2; break;
+            case Op::SNE_REG: if (v[x] != v[y]) pc += 2; break;
+            case Op::SKP: if (v[x] > 0xF) return 0; if ((keys >> v[x]) & 1) pc += 2; break;
+            case Op::SKNP: if (v[x] > 0xF) return 0; if (!((keys >> v[x]) & 1)) pc += 2; break;
+            case Op::LD_VX_DT: v[x] = regs.delay_timer[l]; break;
+            case Op::LD_BYTE: v[x] = kk; break;
+            default: return 0;
+        }
+    }
+    return 0;
+}
+
+// Divide o orçamento em grupos: a cada volta, as lanes com o menor PC e o mesmo opcode
+void LockstepGroup::run_budget(uint16_t budget) {
+    // Lanes paradas em FX0A passam o orçamento em espera
+    std::array<uint16_t, LANES> remaining{};
+    uint32_t ready = 0;
+    for (int l = 0; l < lanes; ++l) {
+        if (lane[l].key_wait_reg >= 0) {
+            idle_cycles[l] += budget;
+        } else {
+            remaining[l] = budget;
+            ready |= 1u << l;
+        }
+    }
+
+    while (ready) {
+        // Avançam primeiro as lanes mais atrasadas no código (menor PC), que tendem a alcançar
+        // as outras no ponto em que os caminhos se juntam
+        int leader = __builtin_ctz(ready);
+        for (uint32_t bits = ready; bits; bits &= bits - 1) {
+            int l = __builtin_ctz(bits);
+            if (regs.PC[l] < regs.PC[leader]) leader = l;
+        }
+        uint16_t pc = regs.PC[leader];
+        uint16_t opcode = read_opcode(leader, pc);
+        uint64_t blocks = (1ull << ((pc & ADDRESS_MASK) / CODE_BLOCK)) | (1ull << (((pc + 1) & ADDRESS_MASK) / CODE_BLOCK));
+        bool shared = !(diverged_blocks & blocks);
+        uint32_t group = 0;
+        int run = budget;
+        for (uint32_t bits = ready; bits; bits &= bits - 1) {
+            int l = __builtin_ctz(bits);
+            if (regs.PC[l] != pc || (!shared && read_opcode(l, pc) != opcode)) continue;
+            group |= 1u << l;
+            run = std::min<int>(run, remaining[l]);
+        }
+
+        if (group == used) {
+            run_group<true>(group, 0, pc, run, remaining);
+        } else {
+            run_group<false>(group, ready & ~group, pc, run, remaining);
+        }
+
+        ready = 0;
+        for (int l = 0; l < lanes; ++l) ready |= (remaining[l] != 0 ? 1u : 0u) << l;
+    }
+}
+
+// Executa as lanes de group juntas: PC e contagem de passos são escalares enquanto elas concordam
+template <bool Full>
+void LockstepGroup::run_group(uint32_t group, uint32_t others, uint16_t pc, int run,
+                              std::array<uint16_t, LANES>& remaining) {
+    const Mask8 m8 = lane_mask(group);
+    const int leader = __builtin_ctz(group);
+    int steps = 0;
+    bool split = false;        // As lanes se separaram: regs.PC já tem o PC de cada uma
+    bool key_wait = false;     // FX0A executado: lanes em espera ficam ociosas no resto do orçamento
+    std::array<uint16_t, LANES> skipped{}; // Instruções de laço ocioso puladas por lane
+
+// Atribui value às lanes do grupo (sem máscara quando todas as lanes em uso estão nele)
+#define CHIP8_LANE_SET(dst, value) ((dst) = Full ? (value) : (m8 ? (value) : (dst)))
+
+// Gravam o PC de cada lane e encerram o grupo quando as lanes de taken saltam e as outras não
+#define CHIP8_LANE_SKIP(taken)                                                              \
+    do {                                                                                    \
+        uint32_t t = (taken) & group;                                                       \
+        if (t == group) {                                                                   \
+            pc += 2;                                                                        \
+        } else if (t) {                                                                     \
+            for (uint32_t bits = group; bits; bits &= bits - 1) {                           \
+                int l = __builtin_ctz(bits);                                                \
+                regs.PC[l] = static_cast<uint16_t>(pc + ((t >> l) & 1 ? 2 : 0));            \
+            }                                                                               \
+            split = true;                                                                   \
+        }                                                                                   \
+    } while (0)
+
+    while (steps < run) {
+        // Outra lane está neste PC: encerra para que o próximo grupo a inclua
+        if (!Full && others && steps > 0) {
+            bool meet = false;
+            for (uint32_t bits = others; bits && !meet; bits &= bits - 1) meet = regs.PC[__builtin_ctz(bits)] == pc;
+            if (meet) break;
+        }
+        // Código em bloco que difere entre as lanes: só continua se o opcode for o mesmo em todas
+        uint64_t blocks = (1ull << ((pc & ADDRESS_MASK) / CODE_BLOCK)) | (1ull << (((pc + 1) & ADDRESS_MASK) / CODE_BLOCK));
+        uint16_t opcode = read_opcode(leader, pc);
+        if (diverged_blocks & blocks) {
+            bool same = true;
+            for (uint32_t bits = group; bits && same; bits &= bits - 1) same = read_opcode(__builtin_ctz(bits), pc) == opcode;
+            if (!same) break;
+        }
+
+        uint8_t x = (opcode & 0x0F00) >> 8;
+        uint8_t y = (opcode & 0x00F0) >> 4;
+        uint8_t n = opcode & 0x000F;
+        uint8_t kk = opcode & 0x00FF;
+        uint16_t nnn = opcode & 0x0FFF;
+        uint16_t at = pc;
+        pc += 2;
+        ++steps;
+
+        switch (OPCODE_TABLE[opcode]) {
+            // 00E0: CLS
+            case Op::CLS:
+                for (uint32_t bits = group; bits; bits &= bits - 1) displays[__builtin_ctz(bits)].clear();
+                break;
+
+            // 00EE: RET (pilha vazia: no-op)
+            case Op::RET: {
+                uint32_t differ = 0;
+                uint16_t target = 0;
+                for (uint32_t bits = group; bits; bits &= bits - 1) {
+                    int l = __builtin_ctz(bits);
+                    regs.PC[l] = pc;
+                    if (regs.SP[l] > 0) regs.PC[l] = lane[l].stack[--regs.SP[l]];
+                    if (l == leader) target = regs.PC[l];
+                    differ |= regs.PC[l] != regs.PC[leader] ? 1u : 0u;
+                }
+                if (differ) {
+                    split = true;
+                } else {
+                    pc = target;
+                }
+                break;
+            }
+
+            // 1NNN: JP addr (um laço ocioso encerra o grupo com as instruções puladas por lane)
+            case Op::JP:
+                pc = nnn;
+                if (idle_skip && at < Config::Memory::SIZE - 1) {
+                    bool shared = !(diverged_blocks & ((2ull << (at / CODE_BLOCK)) - (1ull << (nnn / CODE_BLOCK))));
+                    if (shared && !is_idle_loop_candidate(leader, at, nnn)) break;
+                    bool any = false;
+                    for (uint32_t bits = group; bits; bits &= bits - 1) {
+                        int l = __builtin_ctz(bits);
+                        if (!shared && !is_idle_loop_candidate(l, at, nnn)) continue;
+                        skipped[l] = static_cast<uint16_t>(skip_idle_loop(l, pc, remaining[l] - steps));
+                        any |= skipped[l] != 0;
+                    }
+                    if (any) run = steps;
+                }
+                break;
+
+            // 2NNN: CALL addr (pilha cheia: no-op)
+            case Op::CALL: {
+                uint32_t called = 0;
+                for (uint32_t bits = group; bits; bits &= bits - 1) {
+                    int l = __builtin_ctz(bits);
+                    if (regs.SP[l] >= Config::CPU::STACK_SIZE) continue;
+                    lane[l].stack[regs.SP[l]++] = pc;
+                    called |= 1u << l;
+                }
+                if (called == group) {
+                    pc = nnn;
+                } else if (called) {
+                    for (uint32_t bits = group; bits; bits &= bits - 1) {
+                        int l = __builtin_ctz(bits);
+                        regs.PC[l] = (called >> l) & 1 ? nnn : pc;
+                    }
+                    split = true;
+                }
+                break;
+            }
+
+            // 3XKK, 4XKK, 5XY0, 9XY0: saltos condicionais
+            case Op::SE_BYTE: CHIP8_LANE_SKIP(lane_bits(regs.V[x] == kk)); break;
+            case Op::SNE_BYTE: CHIP8_LANE_SKIP(lane_bits(regs.V[x] != kk)); break;
+            case Op::SE_REG: CHIP8_LANE_SKIP(lane_bits(regs.V[x] == regs.V[y])); break;
+            case Op::SNE_REG: CHIP8_LANE_SKIP(lane_bits(regs.V[x] != regs.V[y])); break;
+
+            // 6XKK, 7XKK, 8XY0-8XY3
+            case Op::LD_BYTE: CHIP8_LANE_SET(regs.V[x], Lanes8{} + kk); break;
+            case Op::ADD_BYTE: CHIP8_LANE_SET(regs.V[x], regs.V[x] + kk); break;
+            case Op::LD_REG: CHIP8_LANE_SET(regs.V[x], regs.V[y]); break;
+            case Op::OR: CHIP8_LANE_SET(regs.V[x], regs.V[x] | regs.V[y]); break;
+            case Op::AND: CHIP8_LANE_SET(regs.V[x], regs.V[x] & regs.V[y]); break;
+            case Op::XOR: CHIP8_LANE_SET(regs.V[x], regs.V[x] ^ regs.V[y]); break;
+
+            // 8XY4-8XYE: VF é escrito antes de Vx, na mesma ordem do exec<K> (x ou y = F importa)
+            case Op::ADD_REG: {
+                Lanes8 vx = regs.V[x];
+                Lanes8 sum = vx + regs.V[y];
+                CHIP8_LANE_SET(regs.V[0xF], reinterpret_cast<Lanes8>(sum < vx) & 1);
+                CHIP8_LANE_SET(regs.V[x], sum);
+                break;
+            }
+            case Op::SUB:
+                CHIP8_LANE_SET(regs.V[0xF], reinterpret_cast<Lanes8>(regs.V[x] > regs.V[y]) & 1);
+                CHIP8_LANE_SET(regs.V[x], regs.V[x] - regs.V[y]);
+                break;
+            case Op::SHR:
+                CHIP8_LANE_SET(regs.V[0xF], regs.V[x] & 1);
+                CHIP8_LANE_SET(regs.V[x], regs.V[x] >> 1);
+                break;
+            case Op::SUBN:
+                CHIP8_LANE_SET(regs.V[0xF], reinterpret_cast<Lanes8>(regs.V[y] > regs.V[x]) & 1);
+                CHIP8_LANE_SET(regs.V[x], regs.V[y] - regs.V[x]);
+                break;
+            case Op::SHL:
+                CHIP8_LANE_SET(regs.V[0xF], regs.V[x] >> 7);
+                CHIP8_LANE_SET(regs.V[x], regs.V[x] << 1);
+                break;
+
+            // ANNN: LD I, addr
+            case Op::LD_I:
+                for (int l = 0; l < LANES; ++l) regs.I[l] = Full || m8[l] ? nnn : regs.I[l];
+                break;
+
+            // BNNN: JP V0, addr
+            case Op::JP_V0:
+                if ((lane_bits(regs.V[0] == regs.V[0][leader]) & group) == group) {
+                    pc = nnn + regs.V[0][leader];
+                } else {
+                    for (uint32_t bits = group; bits; bits &= bits - 1) {
+                        int l = __builtin_ctz(bits);
+                        regs.PC[l] = nnn + regs.V[0][l];
+                    }
+                    split = true;
+                }
+                break;
+
+            // CXKK: RND Vx, byte (xorshift32 de cada lane, como Rng::next_byte)
+            case Op::RND:
+                for (uint32_t bits = group; bits; bits &= bits - 1) {
+                    int l = __builtin_ctz(bits);
+                    uint32_t r = regs.rng[l];
+                    r ^= r << 13;
+                    r ^= r >> 17;
+                    r ^= r << 5;
+                    regs.rng[l] = r;
+                    regs.V[x][l] = static_cast<uint8_t>(r >> 24) & kk;
+                }
+                break;
+
+            // DXYN: sprite lido da RAM de cada lane e desenhado no seu framebuffer
+            case Op::DRW:
+                for (uint32_t bits = group; bits; bits &= bits - 1) {
+                    int l = __builtin_ctz(bits);
+                    uint8_t sprite[15] = {0};
+                    for (uint8_t row = 0; row < n; ++row) sprite[row] = lane[l].ram[(regs.I[l] + row) & ADDRESS_MASK];
+                    regs.V[0xF][l] = displays[l].draw_sprite(regs.V[x][l], regs.V[y][l], sprite, n) ? 1 : 0;
+                }
+                break;
+
+            // EX9E, EXA1: tecla Vx (acima de F nunca está pressionada)
+            case Op::SKP:
+            case Op::SKNP: {
+                uint32_t pressed = 0;
+                for (uint32_t bits = group; bits; bits &= bits - 1) {
+                    int l = __builtin_ctz(bits);
+                    uint8_t key = regs.V[x][l];
+                    if (key < 16 && ((regs.keys[l] >> key) & 1)) pressed |= 1u << l;
+                }
+                CHIP8_LANE_SKIP(OPCODE_TABLE[opcode] == Op::SKP ? pressed : ~pressed);
+                break;
+            }
+
+            // FX07: LD Vx, DT
+            case Op::LD_VX_DT: CHIP8_LANE_SET(regs.V[x], regs.delay_timer); break;
+
+            // FX0A: LD Vx, K (a lane que entra em espera passa o resto do orçamento ociosa)
+            case Op::LD_VX_K:
+                for (uint32_t bits = group; bits; bits &= bits - 1) {
+                    int l = __builtin_ctz(bits);
+                    Lane& s = lane[l];
+                    regs.PC[l] = at;
+                    if (s.key_wait_reg < 0) {
+                        s.key_wait_reg = static_cast<int8_t>(x);
+                        s.key_wait_held = regs.keys[l];
+                        s.key_wait_pressed = 0;
+                        regs.presses[l] = 0; // Toques anteriores à instrução não contam
+                    } else {
+                        resolve_key_wait(l);
+                    }
+                }
+                split = true;
+                key_wait = true;
+                break;
+
+            // FX15, FX18: timers
+            case Op::LD_DT_VX: CHIP8_LANE_SET(regs.delay_timer, regs.V[x]); break;
+            case Op::LD_ST_VX: CHIP8_LANE_SET(regs.sound_timer, regs.V[x]); break;
+
+            // FX1E: ADD I, Vx
+            case Op::ADD_I:
+                for (int l = 0; l < LANES; ++l) regs.I[l] += Full || m8[l] ? regs.V[x][l] : 0;
+                break;
+
+            // FX29: LD F, Vx (sprites de 5 bytes a partir de FONT_START)
+            case Op::LD_F:
+                for (int l = 0; l < LANES; ++l) {
+                    if (Full || m8[l]) regs.I[l] = Config::Memory::FONT_START + (regs.V[x][l] & 0xF) * 5;
+                }
+                break;
+
+            // FX33: LD B, Vx
+            case Op::LD_B:
+                for (uint32_t bits = group; bits; bits &= bits - 1) {
+                    int l = __builtin_ctz(bits);
+                    uint8_t value = regs.V[x][l];
+                    uint16_t address = regs.I[l];
+                    lane[l].ram[address & ADDRESS_MASK] = value / 100;
+                    lane[l].ram[(address + 1) & ADDRESS_MASK] = (value / 10) % 10;
+                    lane[l].ram[(address + 2) & ADDRESS_MASK] = value % 10;
+                }
+                track_write(group, (lane_bits(regs.V[x] == regs.V[x][leader]) & used) == used, 3);
+                break;
+
+            // FX55: LD [I], Vx
+            case Op::LD_MEM_VX: {
+                Mask8 same = ~Mask8{};
+                for (int r = 0; r <= x; ++r) same &= regs.V[r] == regs.V[r][leader];
+                for (uint32_t bits = group; bits; bits &= bits - 1) {
+                    int l = __builtin_ctz(bits);
+                    for (int r = 0; r <= x; ++r) lane[l].ram[(regs.I[l] + r) & ADDRESS_MASK] = regs.V[r][l];
+                }
+                track_write(group, (lane_bits(same) & used) == used, x + 1);
+                break;
+            }
+
+            // FX65: LD Vx, [I]
+            case Op::LD_VX_MEM:
+                for (uint32_t bits = group; bits; bits &= bits - 1) {
+                    int l = __builtin_ctz(bits);
+                    for (int r = 0; r <= x; ++r) regs.V[r][l] = lane[l].ram[(regs.I[l] + r) & ADDRESS_MASK];
+                }
+                break;
+
+            // Opcode desconhecido: no-op
+            case Op::UNKNOWN:
+            case Op::COUNT:
+                break;
+        }
+        if (split) break;
+    }
+#undef CHIP8_LANE_SKIP
+#undef CHIP8_LANE_SET
+
+    issued += steps;
+    executed += static_cast<uint64_t>(steps) * __builtin_popcount(group);
+    for (uint32_t bits = group; bits; bits &= bits - 1) {
+        int l = __builtin_ctz(bits);
+        if (!split) regs.PC[l] = pc;
+        remaining[l] -= steps + skipped[l];
+        idle_cycles[l] += skipped[l];
+        // FX0A: como em CPU::run_interpreter, o resto do orçamento passa em espera
+        if (key_wait && lane[l].key_wait_reg >= 0) {
+            idle_cycles[l] += remaining[l];
+            remaining[l] = 0;
+        }
+    }
+}
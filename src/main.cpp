@@ -1,21 +1,68 @@
 // Ponto de entrada do emulador Chip-8
-// Inicializa SDL, lê argumentos e coordena o loop principal
+// Lê argumentos, escolhe a plataforma (SDL ou headless) e coordena o loop principal
 
 #include "../include/chip8.h"
 #include "../include/config.h"
-#include <SDL2/SDL.h>
+#include "../include/host_link.h"
+#include "../include/memory.h"
+#include "../include/movie.h"
+#include "../include/null_platform.h"
+#include "../include/profiler.h"
+#include "../include/rewind.h"
+#include "../include/trace.h"
+#include "../include/wav_audio.h"
+#ifndef CHIP8_NO_SDL
+#include "../include/sdl_platform.h"
+#endif
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <chrono>
+#include <ctime>
 #include <thread>
 #include <filesystem>
+#include <memory>
+#include <vector>
 
 static void print_usage(const char* exe) {
-    std::cout << "Uso: " << exe << " --rom <arquivo> [--scale <valor>] [--clock <Hz>] [--loadaddr <hex>]" << std::endl;
+    std::cout << "Uso: " << exe << " --rom <arquivo> [--scale <valor>] [--clock <Hz>] [--ipf <n>] [--unthrottled] [--loadaddr <hex>] [--cpu <interp|jit|aot>]"
+              << " [--headless] [--frames <n>] [--cycles <n>] [--no-idle-skip] [--no-fusion] [--save-state <arquivo>] [--load-state <arquivo>] [--rewind <s>]"
+              << " [--seed <n>] [--record <arquivo>] [--replay <arquivo>] [--trace <arquivo>] [--profile <prefixo>] [--wav <arquivo>]" << std::endl;
     std::cout << "  --rom <arquivo>     Caminho da ROM .ch8" << std::endl;
     std::cout << "  --scale <valor>     Fator de escala da janela (padrão: " << Config::Display::DEFAULT_SCALE << ")" << std::endl;
     std::cout << "  --clock <Hz>        Clock da CPU em Hz (padrão: " << Config::CPU::DEFAULT_CLOCK_SPEED << ")" << std::endl;
+    std::cout << "  --ipf <n>           Instruções por quadro de 60 Hz (padrão: clock / 60)" << std::endl;
+    std::cout << "  --unthrottled       Executa o mais rápido possível e informa instruções/s" << std::endl;
     std::cout << "  --loadaddr <hex>    Endereço de carga em hex (padrão: 0x" << std::hex << Config::Memory::PROGRAM_START << std::dec << ")" << std::endl;
+    std::cout << "  --cpu <interp|jit|aot> Motor de execução da CPU (padrão: interp; aot exige o programa gerado pelo chip8-aot)" << std::endl;
+    std::cout << "  --headless          Sem janela, áudio ou teclado; implica --unthrottled e exige --frames ou --cycles" << std::endl;
+    std::cout << "  --frames <n>        Encerra após n quadros emulados" << std::endl;
+    std::cout << "  --cycles <n>        Encerra após o quadro em que n instruções forem atingidas" << std::endl;
+    std::cout << "  --no-idle-skip      Executa laços ociosos (espera por timer/tecla) instrução por instrução" << std::endl;
+    std::cout << "  --no-fusion         Não funde sequências comuns de opcodes no interpretador" << std::endl;
+    std::cout << "  --save-state <arq>  Grava o estado da máquina ao sair (e a cada F5)" << std::endl;
+    std::cout << "  --load-state <arq>  Começa do estado salvo (--rom passa a ser opcional)" << std::endl;
+    std::cout << "  --rewind <s>        Segundos de histórico para rebobinar (padrão: " << Config::Rewind::DEFAULT_SECONDS
+              << " com janela, 0 no headless; 0 desliga)" << std::endl;
+    std::cout << "  --seed <n>          Semente do gerador pseudoaleatório (padrão: relógio)" << std::endl;
+    std::cout << "  --record <arq>      Grava um filme (semente + teclas por quadro) ao sair" << std::endl;
+    std::cout << "  --replay <arq>      Reproduz um filme sem janela e sem limite de velocidade e confere o hash final" << std::endl;
+    std::cout << "  --trace <arq>       Grava cada instrução executada em trace binário (leia com chip8-trace)" << std::endl;
+    std::cout << "  --profile <prefixo> Conta instruções por PC/operação/sub-rotina e acessos à RAM; grava <prefixo>.json e <prefixo>.folded" << std::endl;
+    std::cout << "  --wav <arq>         Grava o áudio emulado em WAV (único áudio do modo headless)" << std::endl;
+    std::cout << "  Atalhos: F5 salva o estado no slot rápido, F9 restaura, Backspace (segurado) rebobina" << std::endl;
+}
+
+// Lê um inteiro positivo de 64 bits para --frames/--cycles
+static bool parse_limit(const char* text, uint64_t& out) {
+    try {
+        long long v = std::stoll(text);
+        if (v <= 0) return false;
+        out = static_cast<uint64_t>(v);
+        return true;
+    } catch (...) {
+        return false;
+    }
 }
 
 int main(int argc, char* argv[]) {
@@ -23,6 +70,28 @@ int main(int argc, char* argv[]) {
     int scale = Config::Display::DEFAULT_SCALE;
     int clock_hz = Config::CPU::DEFAULT_CLOCK_SPEED;
     uint16_t load_addr = Config::Memory::PROGRAM_START;
+    CpuBackend backend = CpuBackend::Interpreter;
+    int ipf = 0; // 0 = derivado de --clock
+    bool unthrottled = false;
+#ifdef CHIP8_NO_SDL
+    bool headless = true; // Binário sem SDL: só existe a plataforma nula
+#else
+    bool headless = false;
+#endif
+    uint64_t max_frames = 0; // 0 = sem limite
+    uint64_t max_cycles = 0; // 0 = sem limite
+    bool idle_skip = true;
+    bool fusion = true;
+    std::string save_state_path;
+    std::string load_state_path;
+    int rewind_seconds = -1; // -1 = padrão do modo
+    bool have_seed = false;
+    uint32_t seed = 0;
+    std::string record_path;
+    std::string replay_path;
+    std::string trace_path;
+    std::string profile_prefix;
+    std::string wav_path;
 
     // Parse simples de argumentos
     for (int i = 1; i < argc; ++i) {
@@ -56,6 +125,76 @@ int main(int argc, char* argv[]) {
                 std::cerr << "[main] ERRO: Valor inválido para --clock" << std::endl;
                 return 1;
             }
+        } else if (arg == "--ipf") {
+            need_value("--ipf");
+            try {
+                ipf = std::stoi(argv[++i]);
+                if (ipf <= 0) throw std::invalid_argument("non-positive");
+            } catch (...) {
+                std::cerr << "[main] ERRO: Valor inválido para --ipf" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--unthrottled") {
+            unthrottled = true;
+        } else if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--save-state") {
+            need_value("--save-state");
+            save_state_path = argv[++i];
+        } else if (arg == "--load-state") {
+            need_value("--load-state");
+            load_state_path = argv[++i];
+        } else if (arg == "--rewind") {
+            need_value("--rewind");
+            try {
+                rewind_seconds = std::stoi(argv[++i]);
+                if (rewind_seconds < 0) throw std::invalid_argument("negative");
+            } catch (...) {
+                std::cerr << "[main] ERRO: Valor inválido para --rewind" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--seed") {
+            need_value("--seed");
+            try {
+                unsigned long long v = std::stoull(argv[++i], nullptr, 0);
+                if (v > 0xFFFFFFFFull) throw std::out_of_range("range");
+                seed = static_cast<uint32_t>(v);
+                have_seed = true;
+            } catch (...) {
+                std::cerr << "[main] ERRO: Valor inválido para --seed" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--record") {
+            need_value("--record");
+            record_path = argv[++i];
+        } else if (arg == "--replay") {
+            need_value("--replay");
+            replay_path = argv[++i];
+        } else if (arg == "--trace") {
+            need_value("--trace");
+            trace_path = argv[++i];
+        } else if (arg == "--profile") {
+            need_value("--profile");
+            profile_prefix = argv[++i];
+        } else if (arg == "--wav") {
+            need_value("--wav");
+            wav_path = argv[++i];
+        } else if (arg == "--no-idle-skip") {
+            idle_skip = false;
+        } else if (arg == "--no-fusion") {
+            fusion = false;
+        } else if (arg == "--frames") {
+            need_value("--frames");
+            if (!parse_limit(argv[++i], max_frames)) {
+                std::cerr << "[main] ERRO: Valor inválido para --frames" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--cycles") {
+            need_value("--cycles");
+            if (!parse_limit(argv[++i], max_cycles)) {
+                std::cerr << "[main] ERRO: Valor inválido para --cycles" << std::endl;
+                return 1;
+            }
         } else if (arg == "--loadaddr") {
             need_value("--loadaddr");
             try {
@@ -66,6 +205,19 @@ int main(int argc, char* argv[]) {
                 std::cerr << "[main] ERRO: Valor inválido para --loadaddr (use ex.: 0x200)" << std::endl;
                 return 1;
             }
+        } else if (arg == "--cpu") {
+            need_value("--cpu");
+            std::string value = argv[++i];
+            if (value == "interp") {
+                backend = CpuBackend::Interpreter;
+            } else if (value == "jit") {
+                backend = CpuBackend::Jit;
+            } else if (value == "aot") {
+                backend = CpuBackend::Aot;
+            } else {
+                std::cerr << "[main] ERRO: Valor inválido para --cpu (use interp, jit ou aot)" << std::endl;
+                return 1;
+            }
         } else if (arg == "--help" || arg == "-h") {
             print_usage(argv[0]);
             return 0;
@@ -76,80 +228,375 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    if (rom_path.empty()) {
-        std::cerr << "[main] ERRO: Parâmetro --rom é obrigatório." << std::endl;
+    if (rom_path.empty() && load_state_path.empty()) {
+        std::cerr << "[main] ERRO: Parâmetro --rom é obrigatório (ou --load-state)." << std::endl;
         print_usage(argv[0]);
         return 1;
     }
-    if (!std::filesystem::exists(rom_path)) {
+    if (!rom_path.empty() && !std::filesystem::exists(rom_path)) {
         std::cerr << "[main] ERRO: Arquivo ROM não encontrado: " << rom_path << std::endl;
         return 1;
     }
 
-    // Inicializa SDL
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_EVENTS) < 0) {
-        std::cerr << "[main] ERRO: Falha ao inicializar SDL: " << SDL_GetError() << std::endl;
+    // Filmes: a execução precisa começar do reset da ROM e seguir só a entrada gravada
+    Movie movie;
+    std::vector<uint8_t> rom_image;
+    const bool recording = !record_path.empty();
+    const bool replaying = !replay_path.empty();
+    if (recording || replaying) {
+        if (recording && replaying) {
+            std::cerr << "[main] ERRO: --record e --replay não podem ser usados juntos." << std::endl;
+            return 1;
+        }
+        if (rom_path.empty() || !load_state_path.empty()) {
+            std::cerr << "[main] ERRO: Filmes exigem --rom e não aceitam --load-state." << std::endl;
+            return 1;
+        }
+        if (!Memory::read_rom_file(rom_path, rom_image)) return 1;
+    }
+    if (replaying) {
+        if (!movie.load_file(replay_path)) return 1;
+        if (Movie::hash_rom(rom_image) != movie.rom_hash) {
+            std::cerr << "[main] ERRO: A ROM não é a mesma usada na gravação do filme." << std::endl;
+            return 1;
+        }
+        // O filme define todos os parâmetros que afetam a execução
+        headless = true;
+        max_frames = movie.frames;
+        max_cycles = 0;
+        ipf = movie.instructions_per_frame;
+        load_addr = movie.load_address;
+        seed = movie.seed;
+        have_seed = true;
+        rewind_seconds = 0;
+    }
+    if (recording) {
+        if (!have_seed) seed = static_cast<uint32_t>(std::time(nullptr));
+        have_seed = true;
+        if (rewind_seconds > 0) {
+            std::cout << "[main] Aviso: --rewind é desligado durante a gravação de filmes." << std::endl;
+        }
+        rewind_seconds = 0; // Voltar no tempo quebraria a correspondência quadro -> entrada
+    }
+
+    if (headless) {
+        // Sem eventos de saída, a execução precisa de um limite
+        if (max_frames == 0 && max_cycles == 0) {
+            std::cerr << "[main] ERRO: O modo headless exige --frames ou --cycles." << std::endl;
+            return 1;
+        }
+        unthrottled = true;
+    }
+
+    // Plataforma: SDL2 (janela, áudio e teclado) ou nula
+    std::unique_ptr<Platform> platform;
+    try {
+        if (headless) {
+            platform = std::make_unique<NullPlatform>();
+        } else {
+#ifndef CHIP8_NO_SDL
+            platform = std::make_unique<SdlPlatform>(scale);
+#endif
+        }
+    } catch (const std::exception& ex) {
+        std::cerr << "[main] ERRO: Falha ao inicializar a plataforma: " << ex.what() << std::endl;
         return 1;
     }
 
     int exit_code = 0;
     {
-        // Escopo para garantir destruição antes de SDL_Quit
+        // Escopo para garantir destruição antes da plataforma
+        std::unique_ptr<Profiler> profiler;
+        if (!profile_prefix.empty()) profiler = std::make_unique<Profiler>();
+        std::unique_ptr<WavAudio> wav;
+        if (!wav_path.empty()) {
+            wav = std::make_unique<WavAudio>(wav_path);
+            if (!wav->is_open()) return 1;
+        }
         Chip8 chip8;
-        try {
-            chip8.initialize(scale, clock_hz);
-        } catch (const std::exception& ex) {
-            std::cerr << "[main] ERRO: Falha na inicialização do Chip8: " << ex.what() << std::endl;
-            SDL_Quit();
+        chip8.initialize(*platform, clock_hz);
+        if (wav) chip8.add_audio_output(*wav);
+
+        if (!rom_path.empty() && !chip8.load_rom(rom_path, load_addr)) {
             return 1;
         }
 
-        if (!chip8.load_rom(rom_path, load_addr)) {
-            SDL_Quit();
-            return 1;
+        // Slot rápido de estado (F5/F9), iniciado com --load-state se houver
+        Snapshot quick_slot;
+        bool have_quick_slot = false;
+        if (!load_state_path.empty()) {
+            if (!quick_slot.load_file(load_state_path)) return 1;
+            chip8.load_state(quick_slot);
+            have_quick_slot = true;
+            std::cout << "[main] Estado restaurado de " << load_state_path << std::endl;
         }
+        chip8.set_cpu_backend(backend);
+        chip8.set_idle_skip(idle_skip);
+        chip8.set_fusion(fusion);
+        if (ipf > 0) chip8.set_instructions_per_frame(ipf);
+        if (have_seed) chip8.set_seed(seed);
+        if (profiler) chip8.set_profiler(profiler.get());
+        if (!trace_path.empty()) {
+            if (!Tracer::instance().open_file(trace_path)) return 1;
+            chip8.set_exec_trace(true);
+        }
+        if (recording) {
+            movie.seed = seed;
+            movie.instructions_per_frame = chip8.get_instructions_per_frame();
+            movie.load_address = load_addr;
+            movie.rom_hash = Movie::hash_rom(rom_image);
+        }
+        size_t replay_cursor = 0;
 
-        // Temporização
+        // Histórico para rebobinar: um delta por quadro emulado
+        if (rewind_seconds < 0) rewind_seconds = headless ? 0 : Config::Rewind::DEFAULT_SECONDS;
+        std::unique_ptr<Rewind> rewind;
+        Snapshot rewind_state;
+        if (rewind_seconds > 0) {
+            rewind = std::make_unique<Rewind>(Config::Rewind::BUFFER_BYTES,
+                                              static_cast<size_t>(rewind_seconds) * Config::CPU::TIMER_FREQUENCY);
+            chip8.save_state(rewind_state);
+            rewind->capture(rewind_state);
+        }
+
+        // Temporização: um quadro emulado a cada 1/60 s (ou sem espera no modo --unthrottled)
         using clock = std::chrono::steady_clock;
-        auto next_cycle = clock::now();
-        auto last_timer = clock::now();
-        const auto cycle_period = std::chrono::nanoseconds(1'000'000'000ll / clock_hz);
-        const auto timer_period = std::chrono::milliseconds(1000 / Config::CPU::TIMER_FREQUENCY);
-
-        bool running = true;
-        while (running) {
-            // Eventos
-            SDL_Event e;
-            while (SDL_PollEvent(&e)) {
-                if (e.type == SDL_QUIT) {
-                    running = false;
-                } else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_ESCAPE) {
-                    running = false;
+        const auto frame_period = std::chrono::nanoseconds(1'000'000'000ll / Config::CPU::TIMER_FREQUENCY);
+        const auto max_lag = frame_period * Config::CPU::MAX_FRAME_LAG;
+
+        // Apresentação no máximo uma vez por quadro do monitor (60 Hz se desconhecido)
+        int refresh_hz = platform->refresh_rate();
+        if (refresh_hz <= 0) refresh_hz = Config::CPU::TIMER_FREQUENCY;
+        const auto present_period = std::chrono::nanoseconds(1'000'000'000ll / refresh_hz);
+
+        // Com janela, a emulação roda em thread própria: a thread principal (SDL) só processa
+        // eventos e apresenta, no ritmo do monitor, e as duas se falam pelo HostLink
+        const bool threaded = !headless;
+        HostLink link;
+
+        const auto start = clock::now();
+        uint64_t frames = 0;
+        uint64_t instructions = 0;
+
+        // Latência entrada->quadro: do momento em que a thread da plataforma vê a mudança de
+        // tecla até o fim do primeiro quadro emulado que a enxerga
+        bool input_pending = false;
+        clock::time_point input_time;
+        double latency_sum_ms = 0, latency_max_ms = 0;
+        uint64_t latency_samples = 0;
+
+        auto emulate = [&]() {
+            auto next_frame = clock::now();
+            bool running = true;
+            while (running) {
+                bool rewinding = false;
+                if (threaded) {
+                    if (link.quit_requested()) break;
+
+                    // Entrada da plataforma, aplicada sempre na fronteira entre quadros
+                    uint16_t mask, presses;
+                    clock::time_point since;
+                    if (link.take_keys(mask, presses, since)) {
+                        chip8.apply_keys(mask, presses);
+                        if (!input_pending) input_time = since;
+                        input_pending = true;
+                    }
+
+                    HostCommand command;
+                    while (link.next_command(command)) {
+                        if (command == HostCommand::SaveState) {
+                            chip8.save_state(quick_slot);
+                            have_quick_slot = true;
+                            if (!save_state_path.empty()) quick_slot.save_file(save_state_path);
+                            std::cout << "[main] Estado salvo no quadro " << frames << std::endl;
+                        } else if (recording) {
+                            std::cout << "[main] Aviso: F9 ignorado durante a gravação de filmes" << std::endl;
+                        } else if (have_quick_slot) {
+                            chip8.load_state(quick_slot);
+                            std::cout << "[main] Estado restaurado no quadro " << frames << std::endl;
+                        }
+                    }
+                    rewinding = rewind && link.rewind_held();
                 }
-                chip8.handle_input(e);
-            }
 
-            // Ciclo de CPU conforme clock
-            auto now = clock::now();
-            if (now >= next_cycle) {
-                chip8.emulate_cycle();
-                next_cycle += cycle_period;
-            } else {
-                // Sleep para não ocupar 100% da CPU
-                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                // Parada em FX0A sem timers e sem tecla nova: um quadro não mudaria nada, então o
+                // tempo emulado fica suspenso até chegar entrada (o filme e o rewind também)
+                bool suspended = threaded && !unthrottled && chip8.is_quiescent() && !input_pending;
+                if (rewinding) {
+                    // Rebobinando: volta um quadro em vez de emular
+                    if (rewind->step_back(rewind_state)) chip8.load_state(rewind_state);
+                } else if (!suspended) {
+                    if (replaying) {
+                        movie.get_input().apply(frames, replay_cursor,
+                                                [&](uint8_t key, bool pressed) { chip8.set_key(key, pressed); });
+                    } else if (recording) {
+                        movie.record(frames, chip8.get_key_mask(), chip8.get_key_presses());
+                    }
+
+                    // Um quadro emulado: ipf instruções + um tick dos timers
+                    instructions += chip8.run_frame();
+                    ++frames;
+                    if (input_pending) {
+                        double ms = std::chrono::duration<double, std::milli>(clock::now() - input_time).count();
+                        latency_sum_ms += ms;
+                        latency_max_ms = std::max(latency_max_ms, ms);
+                        ++latency_samples;
+                        input_pending = false;
+                    }
+                    if (rewind) {
+                        chip8.save_state(rewind_state);
+                        rewind->capture(rewind_state);
+                    }
+                }
+                if ((max_frames && frames >= max_frames) || (max_cycles && instructions >= max_cycles)) running = false;
+
+                // No modo headless não há eventos nem tela: só o núcleo, sem consultar o relógio
+                if (!threaded) continue;
+
+                // Publica o quadro, se mudou; a thread da plataforma pega sempre o mais recente
+                HostLink::Frame& out = link.back_frame();
+                if (chip8.take_frame(out.rows)) {
+                    out.number = frames;
+                    link.publish_frame();
+                }
+
+                // Espera até o próximo quadro; se ficou muito para trás, ressincroniza
+                if (!unthrottled) {
+                    auto now = clock::now();
+                    next_frame += frame_period;
+                    if (now - next_frame > max_lag) next_frame = now;
+                    if (chip8.is_quiescent() && !input_pending && !rewinding) {
+                        // Máquina parada em FX0A: dorme até a plataforma mandar algo e, havendo
+                        // tecla nova, emula o próximo quadro sem esperar a fronteira
+                        link.wait_for_host(now + std::chrono::milliseconds(Config::CPU::QUIESCENT_WAIT_MS));
+                        next_frame = clock::now();
+                    } else {
+                        std::this_thread::sleep_until(next_frame);
+                    }
+                }
             }
+            link.finish();
+        };
+
+        if (!threaded) {
+            emulate();
+        } else {
+            std::thread emulation(emulate);
 
-            // Timers a 60 Hz
-            if (now - last_timer >= timer_period) {
-                chip8.update_timers();
-                last_timer = now;
+            // Thread da plataforma: eventos e apresentação, independentes do ritmo da emulação
+            // (teclado e tela do host têm estado próprio, separado da máquina emulada)
+            InputState host_keys{};
+            DisplayState shown_rows{};
+            Input host_input(host_keys);
+            Display shown(shown_rows);
+            uint64_t host_events = host_input.get_event_count();
+            bool quit_sent = false;
+            auto next_present = clock::now();
+            while (!link.finished()) {
+                auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(next_present - clock::now()).count();
+                bool open = platform->wait_events(host_input, static_cast<int>(std::max<int64_t>(wait, 0)));
+                auto now = clock::now();
+                if (!open && !quit_sent) {
+                    link.request_quit();
+                    quit_sent = true;
+                }
+                if (host_input.get_event_count() != host_events) {
+                    host_events = host_input.get_event_count();
+                    link.post_keys(host_input.get_key_mask(), host_input.take_presses(), now);
+                }
+                HostCommand command;
+                while (platform->next_command(command)) {
+                    if (!link.post_command(command)) std::cerr << "[main] AVISO: Atalho descartado (fila cheia)" << std::endl;
+                }
+                link.set_rewind_held(platform->rewind_held());
+
+                // Apresenta o quadro mais recente (só envia se mudou)
+                if (now >= next_present) {
+                    if (link.update_frame()) shown.set_rows(link.frame().rows);
+                    platform->present(shown);
+                    next_present += present_period;
+                    if (now - next_present > present_period) next_present = now + present_period;
+                }
             }
+            emulation.join();
+        }
 
-            // Atualiza a tela
-            chip8.draw();
+        // Estatísticas de desempenho
+        double seconds = std::chrono::duration<double>(clock::now() - start).count();
+        if (seconds > 0) {
+            std::cout << "[main] " << frames << " quadros, " << instructions << " instruções em "
+                      << seconds << " s (" << static_cast<uint64_t>(instructions / seconds) << " instr/s, "
+                      << static_cast<uint64_t>(frames / seconds) << " quadros/s)" << std::endl;
+            if (instructions > 0) {
+                uint64_t idle = chip8.get_idle_cycles();
+                std::cout << "[main] " << idle << " instruções em laços ociosos puladas ("
+                          << (100.0 * idle / instructions) << "%)" << std::endl;
+                std::array<uint64_t, FUSION_COUNT> hits = chip8.get_fusion_hits();
+                for (size_t f = 0; f < FUSION_COUNT; ++f) {
+                    if (hits[f]) std::cout << "[main] fusão " << FUSION_NAMES[f] << ": " << hits[f] << " execuções" << std::endl;
+                }
+            }
+        }
+        if (latency_samples > 0) {
+            std::cout << "[main] latência entrada->quadro: média " << latency_sum_ms / latency_samples
+                      << " ms, máxima " << latency_max_ms << " ms (" << latency_samples << " mudanças de tecla)" << std::endl;
+        }
+        if (rewind) {
+            std::cout << "[main] rewind: " << rewind->frames() << " quadros guardados, "
+                      << rewind->bytes_used() / 1024 << " KB de " << rewind->capacity() / 1024
+                      << " KB, captura média " << rewind->average_capture_us() << " us" << std::endl;
+        }
+        if (!save_state_path.empty()) {
+            chip8.save_state(quick_slot);
+            if (quick_slot.save_file(save_state_path)) {
+                std::cout << "[main] Estado salvo em " << save_state_path << std::endl;
+            } else {
+                exit_code = 1;
+            }
+        }
+        if (profiler) {
+            if (profiler->save_json(profile_prefix + ".json", rom_path) && profiler->save_folded(profile_prefix + ".folded")) {
+                std::cout << "[main] Profile gravado em " << profile_prefix << ".json e " << profile_prefix << ".folded" << std::endl;
+            } else {
+                exit_code = 1;
+            }
         }
+        if (wav) {
+            if (wav->close()) {
+                std::cout << "[main] Áudio gravado em " << wav_path << " (" << wav->samples_written() << " amostras)" << std::endl;
+            } else {
+                exit_code = 1;
+            }
+        }
+        if (recording) {
+            movie.frames = frames;
+            movie.final_hash = chip8.get_display().hash();
+            if (movie.save_file(record_path)) {
+                std::cout << "[main] Filme gravado em " << record_path << " (" << frames << " quadros, "
+                          << movie.get_input().get_events().size() << " eventos de tecla)" << std::endl;
+            } else {
+                exit_code = 1;
+            }
+        }
+        if (replaying) {
+            uint64_t hash = chip8.get_display().hash();
+            if (hash == movie.final_hash) {
+                std::cout << "[main] Filme reproduzido: hash final confere (0x" << std::hex << hash << std::dec << ")" << std::endl;
+            } else {
+                std::cerr << "[main] ERRO: Filme divergiu: hash final 0x" << std::hex << hash
+                          << ", esperado 0x" << movie.final_hash << std::dec << std::endl;
+                exit_code = 1;
+            }
+        }
+        if (headless) {
+            std::cout << "[main] hash do framebuffer: 0x" << std::hex << chip8.get_display().hash() << std::dec << std::endl;
+        }
+    }
+
+    if (!trace_path.empty()) {
+        Tracer::instance().close_file();
+        std::cout << "[main] Trace gravado em " << trace_path << std::endl;
     }
 
-    SDL_Quit();
     return exit_code;
 }
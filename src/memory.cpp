@@ -2,9 +2,12 @@
 // Responsável por gerenciar os 4KB de RAM, incluindo leitura, escrita e carregamento de ROMs
 
 #include "../include/memory.h"
+#include "../include/trace.h"
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
+#include <cstring>
 
 static const uint8_t CHIP8_FONTS[80] = {
     0xF0, 0x90, 0x90, 0x90, 0xF0,
@@ -26,73 +29,65 @@ static const uint8_t CHIP8_FONTS[80] = {
 };
 
 // Construtor: inicializa a memória e carrega os sprites
-Memory::Memory() {
+template <typename Access>
+BasicMemory<Access>::BasicMemory(std::array<uint8_t, MEMORY_SIZE>& ram, bool verbose) : ram(ram), verbose(verbose) {
     clear();
 }
 
 // Destrutor
-Memory::~Memory() {}
+template <typename Access>
+BasicMemory<Access>::~BasicMemory() {}
 
 // Limpa toda a memória e recarrega os sprites
-void Memory::clear() {
+template <typename Access>
+void BasicMemory<Access>::clear() {
     ram.fill(0);
     load_fonts();
+    notify_write(0, MEMORY_SIZE, WriteSource::Host);
     
-    std::cout << "[Memory] Memória limpa e sprites carregados." << std::endl;
+    if (verbose) std::cout << "[Memory] Memória limpa e sprites carregados." << std::endl;
 }
 
 // Carrega os sprites hexadecimais na área reservada da memória 
-void Memory::load_fonts() {
+template <typename Access>
+void BasicMemory<Access>::load_fonts() {
     for (size_t i = 0; i < FONT_SIZE; ++i) {
         ram[FONT_START + i] = CHIP8_FONTS[i];
     }
 }
 
 // Verifica se um endereço está dentro dos limites válidos da memória
-bool Memory::is_valid_address(uint16_t address) const {
+template <typename Access>
+bool BasicMemory<Access>::is_valid_address(uint16_t address) const {
     return address < MEMORY_SIZE;
 }
 
-// Lê um byte da memória no endereço especificado
-uint8_t Memory::read(uint16_t address) const {
-    if (!is_valid_address(address)) {
+// Política verificada: leitura fora dos limites é erro
+uint16_t CheckedAccess::read_address(uint16_t address) {
+    if (address >= Config::Memory::SIZE) {
         std::cerr << "[Memory] ERRO: Tentativa de leitura em endereço inválido: 0x" 
                   << std::hex << address << std::dec << std::endl;
         throw std::out_of_range("Endereço de memória fora dos limites");
     }
-    
-    return ram[address];
+    return address;
 }
 
-// Escreve um byte na memória no endereço especificado
-void Memory::write(uint16_t address, uint8_t value) {
-    if (!is_valid_address(address)) {
+// Política verificada: escrita fora dos limites é erro; escrita nos sprites gera aviso
+uint16_t CheckedAccess::write_address(uint16_t address) {
+    if (address >= Config::Memory::SIZE) {
         std::cerr << "[Memory] ERRO: Tentativa de escrita em endereço inválido: 0x" 
                   << std::hex << address << std::dec << std::endl;
         throw std::out_of_range("Endereço de memória fora dos limites");
     }
-    if (address < FONT_START + FONT_SIZE) {
-        std::cerr << "[Memory] AVISO: Escrita na área de sprites (0x" 
-                  << std::hex << address << std::dec << ")" << std::endl;
+    if (address < Config::Memory::FONT_START + Config::Memory::FONT_SIZE) {
+        TraceRing::emit_current(TraceKind::FontWrite, static_cast<uint8_t>(address));
     }
-    
-    ram[address] = value;
+    return address;
 }
 
-// Carrega uma ROM do arquivo para a memória
-bool Memory::load_rom(const std::string& rom_path, uint16_t load_address) {
-    // Verifica se o endereço de carregamento é válido
-    if (!is_valid_address(load_address)) {
-        std::cerr << "[Memory] ERRO: Endereço de carregamento inválido: 0x" 
-                  << std::hex << load_address << std::dec << std::endl;
-        return false;
-    }
-    
-    if (load_address <= RESERVED_END) {
-        std::cerr << "[Memory] AVISO: Carregando ROM na área reservada (0x" 
-                  << std::hex << load_address << std::dec << ")" << std::endl;
-    }
-    
+// Lê o conteúdo de um arquivo de ROM
+template <typename Access>
+bool BasicMemory<Access>::read_rom_file(const std::string& rom_path, std::vector<uint8_t>& out) {
     std::ifstream file(rom_path, std::ios::binary | std::ios::ate);
     
     if (!file.is_open()) {
@@ -106,42 +101,107 @@ bool Memory::load_rom(const std::string& rom_path, uint16_t load_address) {
     
     if (file_size <= 0) {
         std::cerr << "[Memory] ERRO: A ROM está vazia: " << rom_path << std::endl;
-        file.close();
         return false;
     }
     
-    // Verifica se a ROM cabe na memória disponível
-    if (load_address + file_size > MEMORY_SIZE) {
-        std::cerr << "[Memory] ERRO: A ROM é muito grande para caber na memória." << std::endl;
-        std::cerr << "           Tamanho: " << file_size << " bytes" << std::endl;
-        std::cerr << "           Espaço disponível: " << (MEMORY_SIZE - load_address) << " bytes" << std::endl;
-        file.close();
+    out.resize(static_cast<size_t>(file_size));
+    if (!file.read(reinterpret_cast<char*>(out.data()), file_size)) {
+        std::cerr << "[Memory] ERRO: Falha ao ler o conteúdo da ROM." << std::endl;
         return false;
     }
+    return true;
+}
+
+// Carrega uma ROM do arquivo para a memória
+template <typename Access>
+bool BasicMemory<Access>::load_rom(const std::string& rom_path, uint16_t load_address) {
+    std::vector<uint8_t> data;
+    if (!read_rom_file(rom_path, data)) return false;
+    if (!load_rom(data.data(), data.size(), load_address)) return false;
     
-    // Lê o conteúdo do arquivo diretamente para a memória
-    if (!file.read(reinterpret_cast<char*>(&ram[load_address]), file_size)) {
-        std::cerr << "[Memory] ERRO: Falha ao ler o conteúdo da ROM." << std::endl;
-        file.close();
+    // Mensagem de sucesso
+    if (verbose) {
+        std::cout << "[Memory] ROM carregada com sucesso!" << std::endl;
+        std::cout << "         Arquivo: " << rom_path << std::endl;
+        std::cout << "         Tamanho: " << data.size() << " bytes" << std::endl;
+        std::cout << "         Endereço: 0x" << std::hex << load_address 
+                  << " - 0x" << (load_address + data.size() - 1) << std::dec << std::endl;
+    }
+    
+    return true;
+}
+
+// Carrega uma ROM já lida para a memória
+template <typename Access>
+bool BasicMemory<Access>::load_rom(const uint8_t* data, size_t size, uint16_t load_address) {
+    // Verifica se o endereço de carregamento é válido
+    if (!is_valid_address(load_address)) {
+        std::cerr << "[Memory] ERRO: Endereço de carregamento inválido: 0x" 
+                  << std::hex << load_address << std::dec << std::endl;
         return false;
     }
     
-    file.close();
+    if (load_address <= RESERVED_END) {
+        std::cerr << "[Memory] AVISO: Carregando ROM na área reservada (0x" 
+                  << std::hex << load_address << std::dec << ")" << std::endl;
+    }
     
-    // Mensagem de sucesso
-    std::cout << "[Memory] ROM carregada com sucesso!" << std::endl;
-    std::cout << "         Arquivo: " << rom_path << std::endl;
-    std::cout << "         Tamanho: " << file_size << " bytes" << std::endl;
-    std::cout << "         Endereço: 0x" << std::hex << load_address 
-              << " - 0x" << (load_address + file_size - 1) << std::dec << std::endl;
+    if (size == 0) {
+        std::cerr << "[Memory] ERRO: A ROM está vazia." << std::endl;
+        return false;
+    }
+    
+    // Verifica se a ROM cabe na memória disponível
+    if (load_address + size > MEMORY_SIZE) {
+        std::cerr << "[Memory] ERRO: A ROM é muito grande para caber na memória." << std::endl;
+        std::cerr << "           Tamanho: " << size << " bytes" << std::endl;
+        std::cerr << "           Espaço disponível: " << (MEMORY_SIZE - load_address) << " bytes" << std::endl;
+        return false;
+    }
     
+    std::copy(data, data + size, ram.begin() + load_address);
+    notify_write(load_address, static_cast<uint16_t>(size), WriteSource::Host);
     return true;
 }
 
+// Substitui toda a RAM, avisando só os trechos de bytes que mudaram: restaurar um clone da
+// mesma ROM quase nunca toca no código, e placar/BCD ao lado do código não o invalidam
+template <typename Access>
+void BasicMemory<Access>::load_ram(const std::array<uint8_t, MEMORY_SIZE>& data) {
+    for (uint16_t block = 0; block < MEMORY_SIZE; block += LOAD_BLOCK) {
+        if (std::memcmp(&ram[block], &data[block], LOAD_BLOCK) == 0) continue;
+        uint16_t end = block + LOAD_BLOCK;
+        for (uint16_t a = block; a < end;) {
+            if (ram[a] == data[a]) {
+                ++a;
+                continue;
+            }
+            uint16_t first = a;
+            while (a < end && ram[a] != data[a]) {
+                ram[a] = data[a];
+                ++a;
+            }
+            notify_write(first, a - first, WriteSource::Host);
+        }
+    }
+}
+
 // Obtém o endereço inicial de um sprite hexadecimal específico
-uint16_t Memory::get_font_address(uint8_t digit) const {
+template <typename Access>
+uint16_t BasicMemory<Access>::get_font_address(uint8_t digit) const {
     // Cada sprite tem 5 bytes, então o endereço é: FONT_START + (digit * 5)
     digit = digit & 0x0F; // Limita o dígito a 0x0-0xF
     return FONT_START + (digit * 5);
 }
 
+
+// Registra quem deve ser avisado sobre escritas
+template <typename Access>
+void BasicMemory<Access>::set_write_listener(WriteListener listener, void* userdata) {
+    write_listener = listener;
+    write_listener_data = userdata;
+}
+
+// As duas políticas são compiladas a partir do mesmo código
+template class BasicMemory<WrappedAccess>;
+template class BasicMemory<CheckedAccess>;
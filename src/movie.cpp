@@ -0,0 +1,120 @@
+// Filmes do Chip-8 (gravação e reprodução determinística)
+// Leitura e escrita do formato texto e registro das mudanças de tecla
+
+#include "../include/movie.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// FNV-1a 64 sobre os bytes da ROM
+uint64_t Movie::hash_rom(const std::vector<uint8_t>& rom) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (uint8_t byte : rom) {
+        hash ^= byte;
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+// Registra as teclas que mudaram desde o quadro anterior
+void Movie::record(uint64_t frame, uint16_t key_mask, uint16_t presses) {
+    for (uint8_t key = 0; key < 16; ++key) {
+        bool was = (last_mask >> key) & 1;
+        bool now = (key_mask >> key) & 1;
+        if ((presses >> key) & 1) {
+            // Houve um toque: solta (se estava segurada), pressiona e deixa no estado final
+            if (was) input.add(frame, key, false);
+            input.add(frame, key, true);
+            if (!now) input.add(frame, key, false);
+        } else if (was != now) {
+            input.add(frame, key, now);
+        }
+    }
+    last_mask = key_mask;
+}
+
+// Grava o filme em arquivo
+bool Movie::save_file(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[Movie] ERRO: Não foi possível criar o filme: " << path << std::endl;
+        return false;
+    }
+    file << "chip8-movie " << VERSION << '\n'
+         << "seed " << seed << '\n'
+         << "ipf " << instructions_per_frame << '\n'
+         << "loadaddr 0x" << std::hex << load_address << '\n'
+         << "rom " << rom_hash << '\n'
+         << "frames " << std::dec << frames << '\n'
+         << "hash " << std::hex << final_hash << std::dec << '\n'
+         << "events\n";
+    input.write(file);
+    if (!file) {
+        std::cerr << "[Movie] ERRO: Falha ao gravar o filme: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Lê o filme de um arquivo
+bool Movie::load_file(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[Movie] ERRO: Não foi possível abrir o filme: " << path << std::endl;
+        return false;
+    }
+
+    std::string line, magic;
+    int version = 0;
+    if (!std::getline(file, line) || !(std::istringstream(line) >> magic >> version) || magic != "chip8-movie") {
+        std::cerr << "[Movie] ERRO: Arquivo não é um filme Chip-8: " << path << std::endl;
+        return false;
+    }
+    if (version != VERSION) {
+        std::cerr << "[Movie] ERRO: Versão de filme não suportada: " << version
+                  << " (esperada " << VERSION << ")" << std::endl;
+        return false;
+    }
+
+    // Cabeçalho "<campo> <valor>" até a linha "events"
+    int line_number = 1;
+    bool have_ipf = false, have_frames = false;
+    while (std::getline(file, line)) {
+        ++line_number;
+        std::istringstream fields(line);
+        std::string name, value;
+        if (!(fields >> name)) continue;
+        if (name == "events") {
+            if (!have_ipf || !have_frames || instructions_per_frame <= 0 || frames == 0) break;
+            last_mask = 0;
+            return input.read(file, path, line_number + 1);
+        }
+        try {
+            if (!(fields >> value)) throw std::invalid_argument("valor");
+            if (name == "seed") {
+                seed = static_cast<uint32_t>(std::stoul(value));
+            } else if (name == "ipf") {
+                instructions_per_frame = std::stoi(value);
+                have_ipf = true;
+            } else if (name == "loadaddr") {
+                unsigned long v = std::stoul(value, nullptr, 16);
+                if (v > 0xFFFF) throw std::out_of_range("loadaddr");
+                load_address = static_cast<uint16_t>(v);
+            } else if (name == "rom") {
+                rom_hash = std::stoull(value, nullptr, 16);
+            } else if (name == "frames") {
+                frames = std::stoull(value);
+                have_frames = true;
+            } else if (name == "hash") {
+                final_hash = std::stoull(value, nullptr, 16);
+            }
+            // Campos desconhecidos são ignorados (extensões futuras)
+        } catch (...) {
+            std::cerr << "[Movie] ERRO: Linha inválida em " << path << ":" << line_number << std::endl;
+            return false;
+        }
+    }
+    std::cerr << "[Movie] ERRO: Cabeçalho incompleto em " << path
+              << " (faltam ipf, frames ou a linha events)" << std::endl;
+    return false;
+}
@@ -0,0 +1,23 @@
+// Plataforma nula do Chip-8 (modo headless)
+// Implementa a interface Platform sem nenhuma dependência do host
+
+#include "../include/null_platform.h"
+
+NullPlatform::NullPlatform() {}
+
+NullPlatform::~NullPlatform() {}
+
+// Nunca há eventos
+bool NullPlatform::poll_events(Input&) {
+    return true;
+}
+
+// Nunca há eventos: retorna sem esperar
+bool NullPlatform::wait_events(Input&, int) {
+    return true;
+}
+
+// Só consome o flag de mudança do framebuffer
+void NullPlatform::present(Display& display) {
+    display.clear_dirty();
+}
@@ -0,0 +1,176 @@
+// Profiler de execução do Chip-8
+// Árvore de chamadas e exportação dos contadores (JSON e pilhas folded)
+
+#include "../include/profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+Profiler::Profiler() {
+    nodes.reserve(256);
+    nodes.push_back(Node{0, 0, 1, 0});
+}
+
+// 2NNN: desce para o nó filho (criado na primeira chamada)
+void Profiler::enter(uint16_t function) {
+    uint64_t key = (uint64_t(current) << 16) | function;
+    auto it = children.find(key);
+    uint32_t child;
+    if (it != children.end()) {
+        child = it->second;
+    } else if (nodes.size() < MAX_NODES) {
+        child = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(Node{current, function, 0, 0});
+        children.emplace(key, child);
+    } else {
+        return; // Árvore cheia: o restante fica no caminho atual
+    }
+    ++nodes[child].calls;
+    current = child;
+}
+
+// Caminho do nó no formato folded
+std::string Profiler::path(uint32_t node) const {
+    std::vector<uint16_t> functions;
+    for (uint32_t n = node; n != 0; n = nodes[n].parent) functions.push_back(nodes[n].function);
+    std::string text = "main";
+    char name[16];
+    for (auto it = functions.rbegin(); it != functions.rend(); ++it) {
+        std::snprintf(name, sizeof(name), ";sub_0x%03x", *it);
+        text += name;
+    }
+    return text;
+}
+
+// Total de instruções contadas
+uint64_t Profiler::total_instructions() const {
+    uint64_t total = 0;
+    for (const Node& node : nodes) total += node.self;
+    return total;
+}
+
+namespace {
+
+// Array de contadores como lista JSON
+void write_array(std::ostream& out, const uint64_t* values, size_t count) {
+    out << '[';
+    for (size_t i = 0; i < count; ++i) {
+        if (i) out << ',';
+        out << values[i];
+    }
+    out << ']';
+}
+
+// Escapa uma string para JSON
+std::string json_string(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", c);
+            out += code;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+}
+
+// Grava os contadores em JSON
+bool Profiler::save_json(const std::string& path_name, const std::string& rom) const {
+    std::ofstream out(path_name);
+    if (!out.is_open()) {
+        std::cerr << "[Profiler] ERRO: Não foi possível criar o arquivo: " << path_name << std::endl;
+        return false;
+    }
+
+    uint64_t idle = 0;
+    for (uint64_t v : idle_hits) idle += v;
+
+    // Por sub-rotina: chamadas, instruções próprias e inclusivas (recursão contada uma vez)
+    struct Totals { uint64_t calls = 0, self = 0, inclusive = 0; };
+    std::map<uint16_t, Totals> functions;
+    std::vector<uint64_t> subtree(nodes.size(), 0);
+    for (size_t n = nodes.size(); n-- > 0;) {
+        subtree[n] += nodes[n].self;
+        if (n != 0) subtree[nodes[n].parent] += subtree[n];
+    }
+    for (size_t n = 1; n < nodes.size(); ++n) {
+        Totals& t = functions[nodes[n].function];
+        t.calls += nodes[n].calls;
+        t.self += nodes[n].self;
+        bool nested = false;
+        for (uint32_t p = nodes[n].parent; p != 0 && !nested; p = nodes[p].parent) {
+            nested = nodes[p].function == nodes[n].function;
+        }
+        if (!nested) t.inclusive += subtree[n];
+    }
+
+    out << "{\n";
+    out << "  \"rom\": " << json_string(rom) << ",\n";
+    out << "  \"instructions\": " << total_instructions() << ",\n";
+    out << "  \"idle_skipped\": " << idle << ",\n";
+
+    out << "  \"ops\": {";
+    for (size_t op = 0; op < OP_COUNT; ++op) {
+        out << (op ? ", " : "") << json_string(OP_NAMES[op]) << ": " << op_counts[op];
+    }
+    out << "},\n";
+
+    out << "  \"families\": {";
+    for (int family = 0; family < 16; ++family) {
+        out << (family ? ", " : "") << "\"" << "0123456789ABCDEF"[family] << "\": " << family_counts[family];
+    }
+    out << "},\n";
+
+    out << "  \"subroutines\": [";
+    bool first = true;
+    for (const auto& [address, t] : functions) {
+        char name[8];
+        std::snprintf(name, sizeof(name), "0x%03x", address);
+        out << (first ? "\n" : ",\n") << "    {\"address\": \"" << name << "\", \"calls\": " << t.calls
+            << ", \"self\": " << t.self << ", \"inclusive\": " << t.inclusive << "}";
+        first = false;
+    }
+    out << (first ? "],\n" : "\n  ],\n");
+
+    out << "  \"pc_hits\": ";
+    write_array(out, pc_hits.data(), pc_hits.size());
+    out << ",\n  \"idle_hits\": ";
+    write_array(out, idle_hits.data(), idle_hits.size());
+    out << ",\n  \"reads\": ";
+    write_array(out, reads.data(), reads.size());
+    out << ",\n  \"writes\": ";
+    write_array(out, writes.data(), writes.size());
+    out << "\n}\n";
+
+    if (!out) {
+        std::cerr << "[Profiler] ERRO: Falha ao gravar: " << path_name << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Grava as pilhas no formato folded
+bool Profiler::save_folded(const std::string& path_name) const {
+    std::ofstream out(path_name);
+    if (!out.is_open()) {
+        std::cerr << "[Profiler] ERRO: Não foi possível criar o arquivo: " << path_name << std::endl;
+        return false;
+    }
+    for (uint32_t n = 0; n < nodes.size(); ++n) {
+        if (nodes[n].self > 0) out << path(n) << ' ' << nodes[n].self << '\n';
+    }
+    if (!out) {
+        std::cerr << "[Profiler] ERRO: Falha ao gravar: " << path_name << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,143 @@
+// Rebobinar (rewind) do Chip-8
+// Deltas XOR/RLE por palavra de 64 bits em um anel de bytes de tamanho fixo
+
+#include "../include/rewind.h"
+#include <chrono>
+#include <cstring>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<Snapshot>::value, "Snapshot é copiado como bytes");
+
+Rewind::Rewind(size_t buffer_bytes, size_t max_frames)
+    : buffer(buffer_bytes), entries(max_frames > 0 ? max_frames : 1),
+      scratch(WORDS * sizeof(uint64_t) + (WORDS + 1) * 2 * sizeof(uint16_t)) {}
+
+// Descarta todo o histórico
+void Rewind::clear() {
+    first = count = write_pos = used = 0;
+    has_head = false;
+}
+
+// Codifica head XOR state em scratch
+size_t Rewind::encode(const Snapshot& state) {
+    const uint8_t* a = reinterpret_cast<const uint8_t*>(&head);
+    const uint8_t* b = reinterpret_cast<const uint8_t*>(&state);
+    uint8_t* out = scratch.data();
+    size_t size = 0;
+    size_t w = 0;
+    while (w < WORDS) {
+        // Palavras iguais (XOR zero)
+        size_t zeros = 0;
+        uint64_t x = 0;
+        while (w < WORDS) {
+            uint64_t wa, wb;
+            std::memcpy(&wa, a + 8 * w, 8);
+            std::memcpy(&wb, b + 8 * w, 8);
+            x = wa ^ wb;
+            if (x) break;
+            ++zeros;
+            ++w;
+        }
+        if (w == WORDS) break; // Zeros finais não precisam ser guardados
+
+        // Palavras diferentes, guardadas como XOR
+        uint16_t header[2] = {static_cast<uint16_t>(zeros), 0};
+        size_t header_at = size;
+        size += sizeof(header);
+        uint16_t literals = 0;
+        while (w < WORDS) {
+            uint64_t wa, wb;
+            std::memcpy(&wa, a + 8 * w, 8);
+            std::memcpy(&wb, b + 8 * w, 8);
+            x = wa ^ wb;
+            if (!x) break;
+            std::memcpy(out + size, &x, 8);
+            size += 8;
+            ++literals;
+            ++w;
+        }
+        header[1] = literals;
+        std::memcpy(out + header_at, header, sizeof(header));
+    }
+    return size;
+}
+
+// Aplica um delta em head
+void Rewind::apply(const uint8_t* delta, size_t size) {
+    uint8_t* h = reinterpret_cast<uint8_t*>(&head);
+    size_t w = 0;
+    size_t pos = 0;
+    while (pos < size) {
+        uint16_t header[2];
+        std::memcpy(header, delta + pos, sizeof(header));
+        pos += sizeof(header);
+        w += header[0];
+        for (uint16_t i = 0; i < header[1]; ++i, ++w, pos += 8) {
+            uint64_t x, word;
+            std::memcpy(&x, delta + pos, 8);
+            std::memcpy(&word, h + 8 * w, 8);
+            word ^= x;
+            std::memcpy(h + 8 * w, &word, 8);
+        }
+    }
+}
+
+void Rewind::drop_oldest() {
+    used -= entries[first].size;
+    first = (first + 1) % entries.size();
+    --count;
+}
+
+// Reserva size bytes no anel
+size_t Rewind::allocate(size_t size) {
+    if (write_pos + size > buffer.size()) {
+        // Não cabe no fim: recomeça do início, liberando os deltas que ficaram no fim
+        while (count > 0 && entries[first].offset >= write_pos) drop_oldest();
+        write_pos = 0;
+    }
+    // Libera os deltas mais antigos que ocupam [write_pos, write_pos + size)
+    while (count > 0) {
+        const Entry& oldest = entries[first];
+        bool overlaps = oldest.offset < write_pos + size && write_pos < oldest.offset + oldest.size;
+        if (!overlaps && count < entries.size()) break;
+        drop_oldest();
+    }
+    size_t offset = write_pos;
+    write_pos += size;
+    return offset;
+}
+
+// Registra o estado do quadro atual
+void Rewind::capture(const Snapshot& state) {
+    auto start = std::chrono::steady_clock::now();
+    if (has_head) {
+        size_t size = encode(state);
+        if (size > buffer.size()) {
+            // Delta maior que o anel inteiro: o histórico não tem como continuar
+            first = count = write_pos = used = 0;
+        } else {
+            size_t offset = allocate(size);
+            std::memcpy(buffer.data() + offset, scratch.data(), size);
+            entries[(first + count) % entries.size()] = Entry{offset, size};
+            ++count;
+            used += size;
+        }
+    }
+    std::memcpy(&head, &state, sizeof(Snapshot));
+    has_head = true;
+    capture_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    ++captures;
+}
+
+// Volta um quadro
+bool Rewind::step_back(Snapshot& state) {
+    if (count == 0) return false;
+    size_t newest = (first + count - 1) % entries.size();
+    const Entry& entry = entries[newest];
+    apply(buffer.data() + entry.offset, entry.size);
+    used -= entry.size;
+    write_pos = entry.offset;
+    --count;
+    std::memcpy(&state, &head, sizeof(Snapshot));
+    return true;
+}
@@ -0,0 +1,52 @@
+// Áudio do Chip-8 via SDL2
+// Sem callback: o dispositivo fica sempre ativo e toca o que o núcleo enfileira; com a
+// fila vazia o SDL emite silêncio
+
+#include "../include/sdl_audio.h"
+#include "../include/config.h"
+#include <iostream>
+#include <stdexcept>
+
+// Inicializa o sistema de áudio e dispositivo
+SdlAudio::SdlAudio() : device(0), max_queued_bytes(0) {
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        std::cerr << "[Audio] ERRO: Não foi possível inicializar SDL2 Audio: " << SDL_GetError() << std::endl;
+        throw std::runtime_error("Falha ao inicializar SDL2 Audio");
+    }
+    SDL_AudioSpec want, have;
+    SDL_zero(want);
+    want.freq = Config::Audio::SAMPLE_RATE;
+    want.format = AUDIO_S16SYS;
+    want.channels = Config::Audio::CHANNELS;
+    want.samples = Config::Audio::BUFFER_SIZE;
+    want.callback = nullptr; // Modo fila (SDL_QueueAudio)
+    // Formato fixo: o SDL converte se o hardware usar outro
+    device = SDL_OpenAudioDevice(nullptr, 0, &want, &have, 0);
+    if (device == 0) {
+        std::cerr << "[Audio] ERRO: Não foi possível abrir dispositivo de áudio: " << SDL_GetError() << std::endl;
+        throw std::runtime_error("Falha ao abrir dispositivo de áudio");
+    }
+    max_queued_bytes = static_cast<Uint32>(Config::Audio::MAX_QUEUED_FRAMES * Config::Audio::SAMPLE_RATE /
+                                           Config::CPU::TIMER_FREQUENCY * sizeof(int16_t));
+    SDL_PauseAudioDevice(device, 0);
+}
+
+// Libera recursos de áudio
+SdlAudio::~SdlAudio() {
+    if (device) {
+        SDL_ClearQueuedAudio(device);
+        SDL_CloseAudioDevice(device);
+    }
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+}
+
+// Enfileira as amostras do quadro
+void SdlAudio::queue_samples(const int16_t* samples, size_t count) {
+    if (!device || count == 0) return;
+    // Acima do tempo real (--unthrottled, quadros atrasados) a fila cresceria sem limite:
+    // quadros excedentes são descartados para manter a latência em poucos quadros
+    if (SDL_GetQueuedAudioSize(device) > max_queued_bytes) return;
+    if (SDL_QueueAudio(device, samples, static_cast<Uint32>(count * sizeof(int16_t))) < 0) {
+        std::cerr << "[Audio] AVISO: Falha ao enfileirar áudio: " << SDL_GetError() << std::endl;
+    }
+}
@@ -0,0 +1,217 @@
+// Plataforma SDL2 do Chip-8
+// Janela, renderer, áudio e teclado físico via SDL2
+
+#include "../include/sdl_platform.h"
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+// Expansão de 8 pixels empacotados (bit 7 = pixel mais à esquerda) em 8 pixels ARGB
+using PixelGroup = std::array<uint32_t, 8>;
+
+constexpr std::array<PixelGroup, 256> make_expand_table() {
+    std::array<PixelGroup, 256> table{};
+    for (int byte = 0; byte < 256; ++byte) {
+        for (int bit = 0; bit < 8; ++bit) {
+            table[byte][bit] = (byte >> (7 - bit)) & 1 ? Config::Display::COLOR_ON : Config::Display::COLOR_OFF;
+        }
+    }
+    return table;
+}
+
+constexpr std::array<PixelGroup, 256> EXPAND_TABLE = make_expand_table();
+
+// Converte uma linha do framebuffer em WIDTH pixels ARGB
+inline void expand_row(uint64_t row, uint32_t* dst) {
+    for (int group = 0; group < Display::WIDTH / 8; ++group) {
+        uint8_t byte = static_cast<uint8_t>(row >> (Display::WIDTH - 8 - 8 * group));
+        std::memcpy(dst + 8 * group, EXPAND_TABLE[byte].data(), sizeof(PixelGroup));
+    }
+}
+
+}
+
+// Inicializa SDL, cria a janela e abre o dispositivo de áudio
+SdlPlatform::SdlPlatform(int scale) : window(nullptr), renderer(nullptr), texture(nullptr), rewind_key_down(false),
+      redraw_pending(false), upload_pending(false) {
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_EVENTS) < 0) {
+        std::cerr << "[Platform] ERRO: Não foi possível inicializar SDL2: " << SDL_GetError() << std::endl;
+        throw std::runtime_error("Falha ao inicializar SDL2");
+    }
+    window = SDL_CreateWindow("CHIP-8 Emulator", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                              Display::WIDTH * scale, Display::HEIGHT * scale, SDL_WINDOW_SHOWN);
+    if (!window) {
+        std::cerr << "[Platform] ERRO: Não foi possível criar a janela SDL: " << SDL_GetError() << std::endl;
+        SDL_Quit();
+        throw std::runtime_error("Falha ao criar janela SDL");
+    }
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    if (!renderer) {
+        std::cerr << "[Platform] ERRO: Não foi possível criar renderer SDL: " << SDL_GetError() << std::endl;
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        throw std::runtime_error("Falha ao criar renderer SDL");
+    }
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+                                Display::WIDTH, Display::HEIGHT);
+    if (!texture) {
+        std::cerr << "[Platform] ERRO: Não foi possível criar textura SDL: " << SDL_GetError() << std::endl;
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        throw std::runtime_error("Falha ao criar textura SDL");
+    }
+    try {
+        sdl_audio = std::make_unique<SdlAudio>();
+    } catch (...) {
+        SDL_DestroyTexture(texture);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        throw;
+    }
+}
+
+// Libera recursos SDL
+SdlPlatform::~SdlPlatform() {
+    sdl_audio.reset();
+    if (texture) SDL_DestroyTexture(texture);
+    if (renderer) SDL_DestroyRenderer(renderer);
+    if (window) SDL_DestroyWindow(window);
+    SDL_Quit();
+}
+
+// Mapeia SDL_Keycode para índice CHIP-8
+int SdlPlatform::map_key(SDL_Keycode key) {
+    switch (key) {
+        case SDLK_1: return 0x1;
+        case SDLK_2: return 0x2;
+        case SDLK_3: return 0x3;
+        case SDLK_4: return 0xC;
+        case SDLK_q: return 0x4;
+        case SDLK_w: return 0x5;
+        case SDLK_e: return 0x6;
+        case SDLK_r: return 0xD;
+        case SDLK_a: return 0x7;
+        case SDLK_s: return 0x8;
+        case SDLK_d: return 0x9;
+        case SDLK_f: return 0xE;
+        case SDLK_z: return 0xA;
+        case SDLK_x: return 0x0;
+        case SDLK_c: return 0xB;
+        case SDLK_v: return 0xF;
+        default: return -1;
+    }
+}
+
+// Atualiza o teclado com um evento SDL
+bool SdlPlatform::handle_event(const SDL_Event& e, Input& input) {
+    if (e.type == SDL_QUIT) return false;
+    if (e.type == SDL_WINDOWEVENT) {
+        // Sem isto a janela fica velha até o jogo desenhar de novo (um jogo parado em FX0A não desenha)
+        switch (e.window.event) {
+            case SDL_WINDOWEVENT_EXPOSED:
+                redraw_pending = true;
+                break;
+            case SDL_WINDOWEVENT_SHOWN:
+            case SDL_WINDOWEVENT_RESTORED:
+            case SDL_WINDOWEVENT_MAXIMIZED:
+            case SDL_WINDOWEVENT_SIZE_CHANGED:
+                upload_pending = true;
+                break;
+            default:
+                break;
+        }
+    }
+    if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) upload_pending = true;
+    if (e.type == SDL_KEYDOWN || e.type == SDL_KEYUP) {
+        if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_ESCAPE) return false;
+        if (e.key.keysym.sym == SDLK_BACKSPACE) rewind_key_down = (e.type == SDL_KEYDOWN);
+        if (e.type == SDL_KEYDOWN && !e.key.repeat) {
+            if (e.key.keysym.sym == SDLK_F5) commands.push_back(HostCommand::SaveState);
+            if (e.key.keysym.sym == SDLK_F9) commands.push_back(HostCommand::LoadState);
+        }
+        int idx = map_key(e.key.keysym.sym);
+        if (idx >= 0) input.set_key(static_cast<uint8_t>(idx), e.type == SDL_KEYDOWN);
+    }
+    return true;
+}
+
+// Processa eventos SDL pendentes
+bool SdlPlatform::poll_events(Input& input) {
+    bool running = true;
+    SDL_Event e;
+    while (SDL_PollEvent(&e)) {
+        if (!handle_event(e, input)) running = false;
+    }
+    return running;
+}
+
+// Retira o próximo atalho pendente
+bool SdlPlatform::next_command(HostCommand& command) {
+    if (commands.empty()) return false;
+    command = commands.front();
+    commands.erase(commands.begin());
+    return true;
+}
+
+// Dorme até chegar um evento (sem acordar a cada milissegundo) e processa os pendentes
+bool SdlPlatform::wait_events(Input& input, int timeout_ms) {
+    SDL_Event e;
+    if (!SDL_WaitEventTimeout(&e, timeout_ms)) return true;
+    bool running = handle_event(e, input);
+    return poll_events(input) && running;
+}
+
+// Envia o framebuffer para a janela, somente se houve mudança ou se a janela pediu redesenho
+void SdlPlatform::present(Display& display) {
+    uint32_t dirty_rows = display.get_dirty_rows();
+    if (upload_pending) dirty_rows = static_cast<uint32_t>((1ull << Display::HEIGHT) - 1);
+    if (!dirty_rows && !redraw_pending) return;
+    display.clear_dirty();
+    upload_pending = false;
+    redraw_pending = false;
+    if (!dirty_rows) {
+        // Nada mudou no framebuffer: a textura já está certa, só a janela precisa ser refeita
+        render();
+        return;
+    }
+
+    // Trava só a faixa de linhas alteradas; a textura de streaming é somente escrita,
+    // então toda a faixa é reescrita (inclusive linhas limpas entre duas sujas)
+    int first = __builtin_ctz(dirty_rows);
+    int last = 31 - __builtin_clz(dirty_rows);
+    SDL_Rect rect{0, first, Display::WIDTH, last - first + 1};
+    void* pixels = nullptr;
+    int pitch = 0;
+    if (SDL_LockTexture(texture, &rect, &pixels, &pitch) != 0) {
+        std::cerr << "[Platform] ERRO: Não foi possível travar a textura SDL: " << SDL_GetError() << std::endl;
+        return;
+    }
+    const auto& rows = display.get_rows();
+    auto* line = static_cast<uint8_t*>(pixels);
+    for (int y = first; y <= last; ++y, line += pitch) {
+        expand_row(rows[y], reinterpret_cast<uint32_t*>(line));
+    }
+    SDL_UnlockTexture(texture);
+    render();
+}
+
+// Desenha a textura na janela inteira
+void SdlPlatform::render() {
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+    SDL_RenderPresent(renderer);
+}
+
+// Taxa de atualização do monitor da janela
+int SdlPlatform::refresh_rate() const {
+    SDL_DisplayMode mode;
+    int index = SDL_GetWindowDisplayIndex(window);
+    if (index >= 0 && SDL_GetCurrentDisplayMode(index, &mode) == 0 && mode.refresh_rate > 0) return mode.refresh_rate;
+    return 0;
+}
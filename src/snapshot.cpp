@@ -0,0 +1,127 @@
+// Estado completo da máquina Chip-8 (save states)
+// Serialização explícita em little-endian, independente do layout das structs no host
+
+#include "../include/snapshot.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+const uint8_t MAGIC[4] = {'C', 'H', '8', 'S'};
+
+void put16(uint8_t* p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+void put32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = (v >> (8 * i)) & 0xFF;
+}
+
+void put64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = (v >> (8 * i)) & 0xFF;
+}
+
+uint16_t get16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t get32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+uint64_t get64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+}
+
+// Gera o blob binário versionado
+std::vector<uint8_t> Snapshot::serialize() const {
+    std::vector<uint8_t> blob(SERIALIZED_SIZE, 0);
+    uint8_t* p = blob.data();
+    std::copy(std::begin(MAGIC), std::end(MAGIC), p);
+    put16(p + 4, VERSION);
+    std::copy(cpu.V.begin(), cpu.V.end(), p + 8);
+    put16(p + 24, cpu.I);
+    put16(p + 26, cpu.PC);
+    p[28] = cpu.SP;
+    p[29] = cpu.delay_timer;
+    p[30] = cpu.sound_timer;
+    for (size_t i = 0; i < cpu.stack.size(); ++i) put16(p + 32 + 2 * i, cpu.stack[i]);
+    put32(p + 64, cpu.rng_state);
+    put16(p + 68, keys);
+    for (size_t y = 0; y < rows.size(); ++y) put64(p + 72 + 8 * y, rows[y]);
+    std::copy(ram.begin(), ram.end(), p + 328);
+    p[SERIALIZED_SIZE_V1] = static_cast<uint8_t>(cpu.key_wait_reg + 1);
+    put16(p + SERIALIZED_SIZE_V1 + 2, cpu.key_wait_held);
+    put16(p + SERIALIZED_SIZE_V1 + 4, cpu.key_wait_pressed);
+    return blob;
+}
+
+// Lê um blob
+bool Snapshot::deserialize(const std::vector<uint8_t>& blob) {
+    if (blob.size() < 8 || !std::equal(std::begin(MAGIC), std::end(MAGIC), blob.begin())) {
+        std::cerr << "[Snapshot] ERRO: Arquivo não é um estado salvo do Chip-8." << std::endl;
+        return false;
+    }
+    const uint8_t* p = blob.data();
+    uint16_t version = get16(p + 4);
+    if (version != VERSION && version != 1) {
+        std::cerr << "[Snapshot] ERRO: Versão de estado não suportada: " << version
+                  << " (esperada " << VERSION << ")" << std::endl;
+        return false;
+    }
+    if (blob.size() != (version == 1 ? SERIALIZED_SIZE_V1 : SERIALIZED_SIZE)) {
+        std::cerr << "[Snapshot] ERRO: Estado salvo truncado ou corrompido (" << blob.size() << " bytes)." << std::endl;
+        return false;
+    }
+    std::copy(p + 8, p + 24, cpu.V.begin());
+    cpu.I = get16(p + 24);
+    cpu.PC = get16(p + 26);
+    cpu.SP = p[28];
+    cpu.delay_timer = p[29];
+    cpu.sound_timer = p[30];
+    for (size_t i = 0; i < cpu.stack.size(); ++i) cpu.stack[i] = get16(p + 32 + 2 * i);
+    cpu.rng_state = get32(p + 64);
+    keys = get16(p + 68);
+    for (size_t y = 0; y < rows.size(); ++y) rows[y] = get64(p + 72 + 8 * y);
+    std::copy(p + 328, p + 328 + ram.size(), ram.begin());
+    cpu.key_wait_reg = -1;
+    cpu.key_wait_held = 0;
+    cpu.key_wait_pressed = 0;
+    if (version >= 2 && p[SERIALIZED_SIZE_V1] != 0) {
+        cpu.key_wait_reg = static_cast<int8_t>((p[SERIALIZED_SIZE_V1] - 1) & 0xF);
+        cpu.key_wait_held = get16(p + SERIALIZED_SIZE_V1 + 2);
+        cpu.key_wait_pressed = get16(p + SERIALIZED_SIZE_V1 + 4);
+    }
+    return true;
+}
+
+// Grava o blob em arquivo
+bool Snapshot::save_file(const std::string& path) const {
+    std::vector<uint8_t> blob = serialize();
+    std::ofstream file(path, std::ios::binary);
+    if (!file.write(reinterpret_cast<const char*>(blob.data()), blob.size())) {
+        std::cerr << "[Snapshot] ERRO: Não foi possível gravar o estado em " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Lê o blob de um arquivo
+bool Snapshot::load_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[Snapshot] ERRO: Não foi possível abrir o estado " << path << std::endl;
+        return false;
+    }
+    std::vector<uint8_t> blob((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return deserialize(blob);
+}
@@ -0,0 +1,33 @@
+// Pool de MachineState para busca em árvore
+// Blocos alocados de uma vez, reciclados por lista livre
+
+#include "../include/state_pool.h"
+
+// Reserva os estados iniciais
+StatePool::StatePool(size_t initial) {
+    grow(initial > 0 ? initial : CHUNK_STATES);
+}
+
+// Retira um estado, crescendo o pool se estiver esgotado
+MachineState* StatePool::acquire() {
+    if (free_list.empty()) grow(CHUNK_STATES);
+    MachineState* state = free_list.back();
+    free_list.pop_back();
+    return state;
+}
+
+// Retira um estado com uma cópia de source
+MachineState* StatePool::clone(const MachineState& source) {
+    MachineState* state = acquire();
+    *state = source;
+    return state;
+}
+
+// Aloca mais count estados (alinhados a 64 bytes pelo new de C++17)
+void StatePool::grow(size_t count) {
+    chunks.emplace_back(new MachineState[count]);
+    MachineState* block = chunks.back().get();
+    total += count;
+    free_list.reserve(total);
+    for (size_t i = count; i-- > 0;) free_list.push_back(&block[i]);
+}
@@ -0,0 +1,94 @@
+// Pool de threads com roubo de trabalho
+// Filas por thread protegidas por mutex; a própria thread usa o fim (LIFO), ladrões o início (FIFO)
+
+#include "../include/thread_pool.h"
+
+namespace {
+// Pool e índice da thread atual (para envios de dentro de uma tarefa)
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local unsigned current_index = 0;
+
+// threads = 0: todos os núcleos do host (pelo menos um)
+unsigned resolve_threads(unsigned threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    return threads == 0 ? 1 : threads;
+}
+}
+
+ThreadPool::ThreadPool(unsigned threads) : thread_count(resolve_threads(threads)) {
+    for (unsigned i = 0; i < thread_count; ++i) queues.push_back(std::make_unique<Queue>());
+    workers.reserve(thread_count);
+    for (unsigned i = 0; i < thread_count; ++i) workers.emplace_back(&ThreadPool::worker_loop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_cv.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+// Enfileira uma tarefa
+void ThreadPool::submit(std::function<void()> task) {
+    unsigned index = current_pool == this ? current_index : next_queue++ % size();
+    ++pending;
+    {
+        // Contada antes de entrar na fila: queued nunca fica abaixo do conteúdo real
+        std::lock_guard<std::mutex> lock(mutex);
+        ++queued;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    work_cv.notify_one();
+}
+
+// Bloqueia até que todas as tarefas enviadas terminem
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    done_cv.wait(lock, [this] { return pending == 0; });
+}
+
+// Retira uma tarefa: do fim da própria fila ou do início das outras
+bool ThreadPool::try_pop(unsigned index, std::function<void()>& task) {
+    for (unsigned i = 0; i < size(); ++i) {
+        Queue& queue = *queues[(index + i) % size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+        if (i == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        --queued;
+        return true;
+    }
+    return false;
+}
+
+// Laço de cada thread
+void ThreadPool::worker_loop(unsigned index) {
+    current_pool = this;
+    current_index = index;
+    std::function<void()> task;
+    while (true) {
+        if (try_pop(index, task)) {
+            task();
+            task = nullptr;
+            if (--pending == 0) {
+                std::lock_guard<std::mutex> lock(mutex);
+                done_cv.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        work_cv.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0) return;
+    }
+}
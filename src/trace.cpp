@@ -0,0 +1,194 @@
+// Trace assíncrono do Chip-8
+// Produção nos anéis das CPUs e drenagem (diagnósticos com limite e arquivo binário) em segundo plano
+
+#include "../include/trace.h"
+#include <iostream>
+
+thread_local TraceRing* TraceRing::current = nullptr;
+
+TraceRing::TraceRing(const uint16_t& pc, const uint8_t* ram) : pc(pc), ram(ram) {}
+
+TraceRing::~TraceRing() {
+    if (attached) Tracer::instance().detach(*this);
+}
+
+// Registra no Tracer no primeiro evento e enfileira
+void TraceRing::push(const TraceEvent& event) {
+    if (!attached) {
+        Tracer::instance().attach(*this);
+        attached = true;
+    }
+    TraceEvent e = event;
+    e.source = source;
+    if (!ring.push(e)) dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Diagnóstico da instrução em execução (o PC já foi avançado pelo fetch)
+void TraceRing::emit(TraceKind kind, uint8_t arg) {
+    uint16_t at = static_cast<uint16_t>((pc - 2) & (Config::Memory::SIZE - 1));
+    uint16_t opcode = at + 1 < Config::Memory::SIZE ? static_cast<uint16_t>((ram[at] << 8) | ram[at + 1]) : 0;
+    push(TraceEvent{at, opcode, kind, arg, 0});
+}
+
+// Trace de execução: sem perdas, o produtor espera a drenagem
+void TraceRing::emit_exec(uint16_t at, uint16_t opcode) {
+    if (!attached) {
+        Tracer::instance().attach(*this);
+        attached = true;
+    }
+    TraceEvent e{at, opcode, TraceKind::Exec, 0, source};
+    while (!ring.push(e)) {
+        Tracer::instance().notify();
+        std::this_thread::yield();
+    }
+}
+
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::~Tracer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    if (drainer.joinable()) drainer.join();
+    close_file();
+    std::lock_guard<std::mutex> lock(mutex);
+    flush_suppressed();
+}
+
+// Passa a gravar todos os eventos em arquivo
+bool Tracer::open_file(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file.is_open()) file.close();
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "[Trace] ERRO: Não foi possível criar o arquivo de trace: " << path << std::endl;
+        return false;
+    }
+    const uint8_t header[8] = {'C', 'H', '8', 'T', VERSION & 0xFF, VERSION >> 8, 0, 0};
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    return true;
+}
+
+// Drena o que houver e fecha o arquivo
+void Tracer::close_file() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (TraceRing* ring : rings) drain(*ring);
+    if (file.is_open()) file.close();
+}
+
+// Registra um anel e inicia a thread de drenagem, se preciso
+void Tracer::attach(TraceRing& ring) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ring.source = next_source++;
+    rings.push_back(&ring);
+    if (!drainer.joinable()) {
+        window_start = std::chrono::steady_clock::now();
+        drainer = std::thread(&Tracer::drain_loop, this);
+    }
+}
+
+// Drena o anel uma última vez e o remove
+void Tracer::detach(TraceRing& ring) {
+    std::lock_guard<std::mutex> lock(mutex);
+    drain(ring);
+    dropped += ring.dropped.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < rings.size(); ++i) {
+        if (rings[i] == &ring) {
+            rings.erase(rings.begin() + i);
+            break;
+        }
+    }
+}
+
+// Thread de fundo: drena todos os anéis periodicamente (ou quando um trace de execução enche)
+void Tracer::drain_loop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        wake.wait_for(lock, std::chrono::milliseconds(Config::Trace::DRAIN_INTERVAL_MS));
+        for (TraceRing* ring : rings) drain(*ring);
+    }
+}
+
+// Esvazia um anel (chamado com mutex travado)
+void Tracer::drain(TraceRing& ring) {
+    TraceEvent batch[256];
+    size_t count;
+    while ((count = ring.ring.pop(batch, 256)) > 0) {
+        if (file.is_open()) {
+            uint8_t bytes[sizeof(batch)];
+            for (size_t i = 0; i < count; ++i) {
+                uint8_t* p = bytes + 8 * i;
+                p[0] = batch[i].pc & 0xFF;
+                p[1] = batch[i].pc >> 8;
+                p[2] = batch[i].opcode & 0xFF;
+                p[3] = batch[i].opcode >> 8;
+                p[4] = static_cast<uint8_t>(batch[i].kind);
+                p[5] = batch[i].arg;
+                p[6] = batch[i].source & 0xFF;
+                p[7] = batch[i].source >> 8;
+            }
+            file.write(reinterpret_cast<const char*>(bytes), static_cast<std::streamsize>(8 * count));
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (batch[i].kind != TraceKind::Exec) report(batch[i]);
+        }
+    }
+}
+
+// Imprime um diagnóstico, respeitando o limite por tipo
+void Tracer::report(const TraceEvent& event) {
+    auto now = std::chrono::steady_clock::now();
+    if (now - window_start >= std::chrono::seconds(1)) {
+        flush_suppressed();
+        shown.fill(0);
+        window_start = now;
+    }
+    size_t kind = static_cast<size_t>(event.kind);
+    if (shown[kind] >= Config::Trace::MESSAGES_PER_SECOND) {
+        ++suppressed[kind];
+        return;
+    }
+    ++shown[kind];
+
+    std::cerr << std::hex;
+    switch (event.kind) {
+        case TraceKind::UnknownOpcode:
+            std::cerr << "[CPU] ERRO: Opcode desconhecido: 0x" << event.opcode;
+            break;
+        case TraceKind::StackOverflow:
+            std::cerr << "[CPU] ERRO: Stack overflow!";
+            break;
+        case TraceKind::StackUnderflow:
+            std::cerr << "[CPU] ERRO: Stack underflow!";
+            break;
+        case TraceKind::InvalidKey:
+            std::cerr << "[Input] ERRO: Tecla inválida consultada: " << std::dec << int(event.arg) << std::hex;
+            break;
+        case TraceKind::FontWrite:
+            std::cerr << "[Memory] AVISO: Escrita na área de sprites (0x" << int(event.arg) << ")";
+            break;
+        default:
+            std::cerr << "[Trace] " << TRACE_KIND_NAMES[kind];
+            break;
+    }
+    std::cerr << " (PC 0x" << event.pc << ")" << std::dec << '\n';
+}
+
+// Resume as mensagens que passaram do limite na janela atual (e os eventos perdidos)
+void Tracer::flush_suppressed() {
+    if (dropped > 0) {
+        std::cerr << "[Trace] AVISO: " << dropped << " eventos descartados com anéis cheios" << std::endl;
+        dropped = 0;
+    }
+    for (size_t kind = 0; kind < TRACE_KIND_COUNT; ++kind) {
+        if (suppressed[kind] == 0) continue;
+        std::cerr << "[Trace] AVISO: " << suppressed[kind] << " mensagens de " << TRACE_KIND_NAMES[kind]
+                  << " suprimidas" << std::endl;
+        suppressed[kind] = 0;
+    }
+}
@@ -0,0 +1,109 @@
+// Ambiente vetorizado: N instâncias headless da mesma ROM avançadas em lote
+
+#include "../include/vec_env.h"
+#include <algorithm>
+#include <stdexcept>
+
+// Cria os executores, carrega a ROM e põe todas as instâncias no estado inicial
+VecEnv::VecEnv(const std::vector<uint8_t>& rom, int count, const VecEnvOptions& options)
+    : count(count), options(options) {
+    if (count <= 0) throw std::invalid_argument("número de instâncias precisa ser positivo");
+
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<unsigned>(threads, static_cast<unsigned>(count));
+    if (threads > 1) pool.reset(new ThreadPool(threads));
+    for (unsigned t = 0; t < threads; ++t) {
+        runners.emplace_back(new Runner);
+        Chip8& chip8 = runners.back()->chip8;
+        chip8.initialize(runners.back()->platform);
+        chip8.set_cpu_backend(options.backend);
+        if (options.ipf > 0) chip8.set_instructions_per_frame(options.ipf);
+    }
+
+    // O estado de boot sai do primeiro executor; os outros só restauram estados
+    if (!runners[0]->chip8.load_rom(rom, options.load_address)) {
+        throw std::invalid_argument("ROM não cabe na memória");
+    }
+    runners[0]->chip8.save_state(boot);
+
+    states.resize(count);
+    pixels.resize(count * FRAME_BYTES);
+    sound_flags.resize(count);
+    waiting_flags.resize(count);
+    reset();
+}
+
+VecEnv::~VecEnv() {}
+
+// Divide as instâncias em faixas contíguas, uma por executor
+template <typename Fn>
+void VecEnv::for_each_instance(Fn fn) {
+    if (!pool) {
+        for (int i = 0; i < count; ++i) fn(*runners[0], i);
+        return;
+    }
+    int chunk = (count + static_cast<int>(runners.size()) - 1) / static_cast<int>(runners.size());
+    for (size_t r = 0; r < runners.size(); ++r) {
+        int begin = static_cast<int>(r) * chunk;
+        int end = std::min(count, begin + chunk);
+        if (begin >= end) break;
+        Runner* runner = runners[r].get();
+        pool->submit([=] {
+            for (int i = begin; i < end; ++i) fn(*runner, i);
+        });
+    }
+    pool->wait();
+}
+
+// Volta todas as instâncias ao estado inicial
+void VecEnv::reset(const uint32_t* seeds) {
+    for_each_instance([&](Runner& runner, int i) {
+        boot_instance(runner, i, seeds ? seeds[i] : options.seed + static_cast<uint32_t>(i));
+    });
+}
+
+// Volta uma instância ao estado inicial
+void VecEnv::reset_one(int index, uint32_t seed) {
+    if (index < 0 || index >= count) return;
+    boot_instance(*runners[0], index, seed);
+}
+
+// Estado inicial com a semente dada
+void VecEnv::boot_instance(Runner& runner, int index, uint32_t seed) {
+    runner.chip8.load_state(boot);
+    runner.chip8.set_seed(seed);
+    runner.chip8.save_state(states[index]);
+    publish(index);
+}
+
+// Avança todas as instâncias frames quadros
+void VecEnv::step(const uint16_t* keys, int frames) {
+    for_each_instance([&](Runner& runner, int i) {
+        Chip8& chip8 = runner.chip8;
+        chip8.load_state(states[i]);
+        chip8.apply_keys(keys ? keys[i] : 0, 0);
+        for (int f = 0; f < frames; ++f) chip8.run_frame();
+        chip8.save_state(states[i]);
+        publish(i);
+    });
+}
+
+// Maior número de blocos do JIT marcados para o interpretador entre os executores
+int VecEnv::get_jit_interpreted_blocks() const {
+    int most = 0;
+    for (const auto& runner : runners) most = std::max(most, runner->chip8.get_jit_interpreted_blocks());
+    return most;
+}
+
+// Copia o framebuffer (bytes em ordem de coluna) e os flags da instância
+void VecEnv::publish(int index) {
+    const MachineState& state = states[index];
+    uint8_t* out = &pixels[index * FRAME_BYTES];
+    for (uint64_t row : state.display.rows) {
+        for (int byte = 0; byte < Display::WIDTH / 8; ++byte) {
+            *out++ = static_cast<uint8_t>(row >> (Display::WIDTH - 8 - 8 * byte));
+        }
+    }
+    sound_flags[index] = state.cpu.sound_timer > 0;
+    waiting_flags[index] = state.cpu.key_wait_reg >= 0;
+}
@@ -0,0 +1,86 @@
+// Saída de áudio em arquivo WAV
+// Cabeçalho RIFF/WAVE canônico de 44 bytes, amostras little-endian
+
+#include "../include/wav_audio.h"
+#include "../include/config.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+void put16(uint8_t* p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+void put32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = (v >> (8 * i)) & 0xFF;
+}
+
+}
+
+// Abre o arquivo e escreve o cabeçalho
+WavAudio::WavAudio(const std::string& path) : file(nullptr), path(path), samples(0), failed(false) {
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "[Audio] ERRO: Não foi possível criar o arquivo WAV: " << path << std::endl;
+        return;
+    }
+    uint8_t header[HEADER_SIZE] = {'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V', 'E',
+                                   'f', 'm', 't', ' ', 0, 0, 0, 0, 0, 0, 0, 0,
+                                   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                   'd', 'a', 't', 'a', 0, 0, 0, 0};
+    const uint16_t channels = 1;
+    const uint16_t bits = 16;
+    put32(header + 16, 16);                                       // Tamanho do bloco fmt
+    put16(header + 20, 1);                                        // PCM
+    put16(header + 22, channels);
+    put32(header + 24, Config::Audio::SAMPLE_RATE);
+    put32(header + 28, Config::Audio::SAMPLE_RATE * channels * bits / 8);
+    put16(header + 32, channels * bits / 8);
+    put16(header + 34, bits);
+    failed = std::fwrite(header, 1, HEADER_SIZE, file) != HEADER_SIZE;
+}
+
+WavAudio::~WavAudio() {
+    close();
+}
+
+// Acrescenta as amostras ao arquivo
+void WavAudio::queue_samples(const int16_t* data, size_t count) {
+    if (!file || failed) return;
+    uint8_t chunk[2 * 1024];
+    while (count > 0) {
+        size_t n = std::min<size_t>(count, sizeof(chunk) / 2);
+        for (size_t i = 0; i < n; ++i) put16(chunk + 2 * i, static_cast<uint16_t>(data[i]));
+        if (std::fwrite(chunk, 2, n, file) != n) {
+            std::cerr << "[Audio] ERRO: Falha ao escrever no arquivo WAV: " << path << std::endl;
+            failed = true;
+            return;
+        }
+        samples += n;
+        data += n;
+        count -= n;
+    }
+}
+
+// Corrige os tamanhos do cabeçalho e fecha
+bool WavAudio::close() {
+    if (!file) return !failed;
+    const uint64_t data_bytes = samples * 2;
+    if (data_bytes + HEADER_SIZE - 8 > 0xFFFFFFFFull) {
+        std::cerr << "[Audio] AVISO: WAV maior que 4 GB, cabeçalho truncado: " << path << std::endl;
+    }
+    uint8_t size[4];
+    put32(size, static_cast<uint32_t>(data_bytes + HEADER_SIZE - 8));
+    bool ok = !failed && std::fseek(file, 4, SEEK_SET) == 0 && std::fwrite(size, 1, 4, file) == 4;
+    put32(size, static_cast<uint32_t>(data_bytes));
+    ok = ok && std::fseek(file, 40, SEEK_SET) == 0 && std::fwrite(size, 1, 4, file) == 4;
+    ok = (std::fclose(file) == 0) && ok;
+    file = nullptr;
+    if (!ok) {
+        std::cerr << "[Audio] ERRO: Falha ao finalizar o arquivo WAV: " << path << std::endl;
+        failed = true;
+    }
+    return ok;
+}
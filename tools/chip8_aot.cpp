@@ -0,0 +1,365 @@
+// Recompilador estático (AOT) do Chip-8
+// Desmonta a ROM a partir do ponto de entrada, monta o grafo de fluxo (JP, CALL/RET, saltos
+// condicionais e, por heurística, os destinos de BNNN) e gera uma unidade de tradução C++ com
+// uma função por bloco básico. Ligada ao núcleo (ver aot.h), ela vira o motor --cpu aot.
+
+#include "../include/config.h"
+#include "../include/memory.h"
+#include "../include/opcodes.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int MAX_BLOCK_INSTRUCTIONS = 32; // Um bloco cabe em dois trechos de invalidação do Aot
+constexpr int MAX_JUMP_TABLE = 128;        // Entradas 1NNN seguidas aceitas como tabela de BNNN
+
+void print_usage(const char* exe) {
+    std::cout << "Uso: " << exe << " --rom <arquivo> [--loadaddr <hex>] [--output <arquivo.cpp>] [--name <nome>]" << std::endl;
+    std::cout << "  --rom <arquivo>       ROM a traduzir" << std::endl;
+    std::cout << "  --loadaddr <hex>      Endereço de carga (padrão: 0x" << std::hex << Config::Memory::PROGRAM_START << std::dec << ")" << std::endl;
+    std::cout << "  --output <arquivo>    Grava o C++ no arquivo em vez da saída padrão" << std::endl;
+    std::cout << "  --name <nome>         Nome do programa nas mensagens (padrão: nome do arquivo da ROM)" << std::endl;
+}
+
+// ROM posicionada na memória
+struct Image {
+    uint16_t load;
+    std::vector<uint8_t> bytes;
+
+    // O opcode inteiro em address está na ROM
+    bool contains(uint32_t address) const { return address >= load && address + 2 <= load + bytes.size(); }
+
+    uint16_t opcode(uint16_t address) const {
+        return static_cast<uint16_t>((bytes[address - load] << 8) | bytes[address - load + 1]);
+    }
+};
+
+// Instruções que encerram o bloco: o PC seguinte depende de estado ou a instrução escreve na RAM
+bool ends_block(Op op) {
+    switch (op) {
+        case Op::JP: case Op::CALL: case Op::RET: case Op::JP_V0:
+        case Op::SE_BYTE: case Op::SNE_BYTE: case Op::SE_REG: case Op::SNE_REG:
+        case Op::SKP: case Op::SKNP: case Op::LD_VX_K: case Op::LD_B: case Op::LD_MEM_VX: return true;
+        default: return false;
+    }
+}
+
+// Instruções que podem mudar V0 (o valor de V0 conhecido para o BNNN deixa de valer)
+bool writes_v0(Op op, uint8_t x) {
+    switch (op) {
+        case Op::LD_VX_MEM: return true;
+        case Op::LD_BYTE: case Op::ADD_BYTE: case Op::LD_REG: case Op::OR: case Op::AND: case Op::XOR:
+        case Op::ADD_REG: case Op::SUB: case Op::SHR: case Op::SUBN: case Op::SHL: case Op::RND:
+        case Op::LD_VX_DT: case Op::LD_VX_K: return x == 0;
+        default: return false;
+    }
+}
+
+// Grafo de fluxo: endereços que iniciam blocos
+class FlowGraph {
+public:
+    explicit FlowGraph(const Image& image) : image(image) {}
+
+    // Percorre o código alcançável a partir de entry
+    void explore(uint16_t entry) {
+        add_leader(entry);
+        while (!work.empty()) {
+            uint16_t pc = work.back();
+            work.pop_back();
+            walk(pc);
+        }
+    }
+
+    const std::set<uint16_t>& get_leaders() const { return leaders; }
+    int get_unresolved() const { return unresolved; }
+
+private:
+    const Image& image;
+    std::set<uint16_t> leaders;
+    std::set<uint16_t> walked;
+    std::vector<uint16_t> work;
+    int unresolved = 0; // BNNN sem destino deduzido
+
+    void add_leader(uint32_t pc) {
+        if (!image.contains(pc)) return;
+        if (leaders.insert(static_cast<uint16_t>(pc)).second) work.push_back(static_cast<uint16_t>(pc));
+    }
+
+    // Segue o código linear a partir de pc até um desvio, registrando os sucessores
+    void walk(uint16_t pc) {
+        int v0 = -1; // Valor de V0 se conhecido desde o início do trecho
+        for (uint32_t a = pc; image.contains(a); a += 2) {
+            if (!walked.insert(static_cast<uint16_t>(a)).second) return; // Sucessores já registrados
+            uint16_t opcode = image.opcode(static_cast<uint16_t>(a));
+            Op op = OPCODE_TABLE[opcode];
+            uint16_t nnn = opcode & 0x0FFF;
+            uint8_t x = (opcode & 0x0F00) >> 8;
+            switch (op) {
+                case Op::JP: add_leader(nnn); return;
+                case Op::CALL: add_leader(nnn); add_leader(a + 2); return;
+                case Op::RET: return;
+                case Op::JP_V0: resolve_jump_table(nnn, v0); return;
+                case Op::SE_BYTE: case Op::SNE_BYTE: case Op::SE_REG: case Op::SNE_REG:
+                case Op::SKP: case Op::SKNP:
+                    add_leader(a + 2);
+                    add_leader(a + 4);
+                    return;
+                case Op::LD_VX_K: case Op::LD_B: case Op::LD_MEM_VX: add_leader(a + 2); return;
+                default: break;
+            }
+            if (op == Op::LD_BYTE && x == 0) v0 = opcode & 0x00FF;
+            else if (writes_v0(op, x)) v0 = -1;
+        }
+    }
+
+    // BNNN: com V0 conhecido, um destino; senão, a tabela de 1NNN que começa em NNN
+    void resolve_jump_table(uint16_t nnn, int v0) {
+        if (v0 >= 0) {
+            add_leader(nnn + v0);
+            return;
+        }
+        int entries = 0;
+        for (uint32_t a = nnn; entries < MAX_JUMP_TABLE && image.contains(a) && OPCODE_TABLE[image.opcode(static_cast<uint16_t>(a))] == Op::JP; a += 2) {
+            add_leader(a);
+            ++entries;
+        }
+        if (entries == 0) ++unresolved;
+    }
+};
+
+// Bloco a emitir
+struct Block {
+    uint16_t pc;
+    uint16_t instructions;
+    uint16_t jump; // 1NNN final (0 = outro final)
+    std::string body;
+};
+
+std::string hex(unsigned value, int digits) {
+    char text[16];
+    std::snprintf(text, sizeof(text), "0x%0*X", digits, value);
+    return text;
+}
+
+// Emite o C++ de uma instrução em a. V e I ficam em variáveis locais do bloco: são gravados no
+// CpuState antes de cada chamada ao interpretador e antes do desvio final (que deixa o PC)
+void emit_instruction(std::ostringstream& out, uint16_t a, uint16_t opcode) {
+    Op op = OPCODE_TABLE[opcode];
+    std::string x = hex((opcode & 0x0F00) >> 8, 1);
+    std::string y = hex((opcode & 0x00F0) >> 4, 1);
+    std::string kk = hex(opcode & 0x00FF, 2);
+    std::string nnn = hex(opcode & 0x0FFF, 3);
+    std::string next = hex(a + 2u, 3);
+    std::string skip = hex(a + 4u, 3);
+    std::string vx = "V[" + x + "]";
+    std::string vy = "V[" + y + "]";
+    std::string exec = "c.exec(" + hex(opcode, 4) + ", " + next + ");";
+
+    out << "    // " << hex(a, 3) << ": " << hex(opcode, 4) << "  " << OP_NAMES[static_cast<size_t>(op)] << "\n";
+    if (ends_block(op)) out << "    c.store(V, I);\n";
+    switch (op) {
+        case Op::JP: out << "    s.PC = " << nnn << ";\n"; break;
+        case Op::CALL:
+            out << "    if (s.SP < Config::CPU::STACK_SIZE) { s.stack[s.SP++] = " << next << "; s.PC = " << nnn << "; } else " << exec << "\n";
+            break;
+        case Op::RET: out << "    if (s.SP > 0) s.PC = s.stack[--s.SP]; else " << exec << "\n"; break;
+        case Op::SE_BYTE: out << "    s.PC = " << vx << " == " << kk << " ? " << skip << " : " << next << ";\n"; break;
+        case Op::SNE_BYTE: out << "    s.PC = " << vx << " != " << kk << " ? " << skip << " : " << next << ";\n"; break;
+        case Op::SE_REG: out << "    s.PC = " << vx << " == " << vy << " ? " << skip << " : " << next << ";\n"; break;
+        case Op::SNE_REG: out << "    s.PC = " << vx << " != " << vy << " ? " << skip << " : " << next << ";\n"; break;
+        case Op::JP_V0: out << "    s.PC = " << nnn << " + V[0x0];\n"; break;
+        case Op::LD_BYTE: out << "    " << vx << " = " << kk << ";\n"; break;
+        case Op::ADD_BYTE: out << "    " << vx << " += " << kk << ";\n"; break;
+        case Op::LD_REG: out << "    " << vx << " = " << vy << ";\n"; break;
+        case Op::OR: out << "    " << vx << " |= " << vy << ";\n"; break;
+        case Op::AND: out << "    " << vx << " &= " << vy << ";\n"; break;
+        case Op::XOR: out << "    " << vx << " ^= " << vy << ";\n"; break;
+        // As operações com VF repetem a ordem do interpretador (X ou Y podem ser F)
+        case Op::ADD_REG:
+            out << "    { uint16_t sum = " << vx << " + " << vy << "; V[0xF] = sum > 0xFF ? 1 : 0; " << vx << " = sum & 0xFF; }\n";
+            break;
+        case Op::SUB: out << "    V[0xF] = " << vx << " > " << vy << " ? 1 : 0; " << vx << " -= " << vy << ";\n"; break;
+        case Op::SHR: out << "    V[0xF] = " << vx << " & 0x1; " << vx << " >>= 1;\n"; break;
+        case Op::SUBN: out << "    V[0xF] = " << vy << " > " << vx << " ? 1 : 0; " << vx << " = " << vy << " - " << vx << ";\n"; break;
+        case Op::SHL: out << "    V[0xF] = (" << vx << " & 0x80) >> 7; " << vx << " <<= 1;\n"; break;
+        case Op::LD_I: out << "    I = " << nnn << ";\n"; break;
+        case Op::LD_VX_DT: out << "    " << vx << " = s.delay_timer;\n"; break;
+        case Op::LD_DT_VX: out << "    s.delay_timer = " << vx << ";\n"; break;
+        case Op::LD_ST_VX: out << "    s.sound_timer = " << vx << ";\n"; break;
+        case Op::ADD_I: out << "    I += " << vx << ";\n"; break;
+        case Op::LD_VX_MEM: {
+            // Leitura direta só dentro da RAM; o resto segue a política de acesso do núcleo
+            int count = ((opcode & 0x0F00) >> 8) + 1;
+            out << "    if (I + " << hex(count - 1, 1) << " < Memory::MEMORY_SIZE) {";
+            for (int i = 0; i < count; ++i) out << " V[" << hex(i, 1) << "] = c.ram[I + " << i << "];";
+            out << " } else { c.store(V, I); " << exec << " c.load(V, I); }\n";
+            break;
+        }
+        default:
+            // CLS, DRW, RND, teclas, FX0A, FX29, FX33, FX55 e opcodes desconhecidos
+            if (ends_block(op)) out << "    " << exec << "\n";
+            else out << "    c.store(V, I); " << exec << " c.load(V, I);\n";
+            break;
+    }
+}
+
+// Gera os blocos a partir dos líderes: cada um segue até um desvio, o próximo líder ou o limite
+std::vector<Block> build_blocks(const Image& image, std::set<uint16_t> leaders) {
+    std::vector<Block> blocks;
+    std::set<uint16_t> pending(leaders.begin(), leaders.end());
+    while (!pending.empty()) {
+        uint16_t pc = *pending.begin();
+        pending.erase(pending.begin());
+        Block block{pc, 0, 0, ""};
+        std::ostringstream body;
+        uint32_t a = pc;
+        bool terminated = false;
+        while (image.contains(a) && block.instructions < MAX_BLOCK_INSTRUCTIONS) {
+            if (a != pc && leaders.count(static_cast<uint16_t>(a))) break;
+            uint16_t opcode = image.opcode(static_cast<uint16_t>(a));
+            Op op = OPCODE_TABLE[opcode];
+            emit_instruction(body, static_cast<uint16_t>(a), opcode);
+            ++block.instructions;
+            a += 2;
+            if (ends_block(op)) {
+                if (op == Op::JP) block.jump = static_cast<uint16_t>(a - 2);
+                terminated = true;
+                break;
+            }
+        }
+        if (!terminated) {
+            body << "    c.store(V, I);\n";
+            body << "    s.PC = " << hex(a, 3) << ";\n";
+            // O bloco cortado pelo limite continua em outro
+            if (image.contains(a) && leaders.insert(static_cast<uint16_t>(a)).second) pending.insert(static_cast<uint16_t>(a));
+        }
+        block.body = body.str();
+        blocks.push_back(block);
+    }
+    return blocks;
+}
+
+// Escreve a unidade de tradução
+void write_program(std::ostream& out, const std::string& name, const std::string& rom_path, const Image& image,
+                   const std::vector<Block>& blocks) {
+    out << "// Gerado pelo chip8-aot a partir de " << rom_path << "; não editar\n";
+    out << "// " << blocks.size() << " blocos básicos; ligue ao núcleo e use --cpu aot\n\n";
+    out << "#include \"aot.h\"\n\n";
+    out << "namespace {\n\n";
+    out << "const uint8_t IMAGE[" << image.bytes.size() << "] = {";
+    for (size_t i = 0; i < image.bytes.size(); ++i) {
+        out << (i % 16 == 0 ? "\n    " : " ") << hex(image.bytes[i], 2) << ",";
+    }
+    out << "\n};\n";
+    for (const Block& block : blocks) {
+        out << "\nvoid block_" << hex(block.pc, 3).substr(2) << "(AotContext& c) {\n";
+        if (block.body.find("s.") != std::string::npos) out << "    CpuState& s = c.state;\n";
+        out << "    uint8_t V[16];\n";
+        out << "    uint16_t I;\n";
+        out << "    c.load(V, I);\n";
+        out << block.body << "}\n";
+    }
+    out << "\nconst AotBlock BLOCKS[] = {\n";
+    for (const Block& block : blocks) {
+        out << "    {" << hex(block.pc, 3) << ", " << block.instructions * 2 << ", " << block.instructions << ", "
+            << hex(block.jump, 3) << ", &block_" << hex(block.pc, 3).substr(2) << "},\n";
+    }
+    out << "};\n\n";
+    out << "const AotProgram PROGRAM = {\"" << name << "\", " << hex(image.load, 3) << ", IMAGE, sizeof(IMAGE), BLOCKS, "
+        << "sizeof(BLOCKS) / sizeof(BLOCKS[0])};\n\n";
+    out << "const AotRegistration REGISTRATION(PROGRAM);\n\n";
+    out << "}\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string rom_path;
+    std::string output;
+    std::string name;
+    uint16_t load_addr = Config::Memory::PROGRAM_START;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&](const char* option) -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "[aot] ERRO: Falta valor para " << option << std::endl;
+                print_usage(argv[0]);
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+        if (arg == "--rom") {
+            rom_path = value("--rom");
+        } else if (arg == "--output") {
+            output = value("--output");
+        } else if (arg == "--name") {
+            name = value("--name");
+        } else if (arg == "--loadaddr") {
+            try {
+                unsigned long v = std::stoul(value("--loadaddr"), nullptr, 0);
+                if (v >= Config::Memory::SIZE) throw std::out_of_range("range");
+                load_addr = static_cast<uint16_t>(v);
+            } catch (...) {
+                std::cerr << "[aot] ERRO: Valor inválido para --loadaddr" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "[aot] ERRO: Opção desconhecida: " << arg << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (rom_path.empty()) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    Image image{load_addr, {}};
+    if (!Memory::read_rom_file(rom_path, image.bytes)) return 1;
+    if (image.bytes.empty() || load_addr + image.bytes.size() > Config::Memory::SIZE) {
+        std::cerr << "[aot] ERRO: ROM vazia ou maior que a memória a partir de " << hex(load_addr, 3) << std::endl;
+        return 1;
+    }
+    if (name.empty()) name = rom_path.substr(rom_path.find_last_of("/\\") + 1);
+    for (char& ch : name) {
+        if (ch == '"' || ch == '\\') ch = '_';
+    }
+
+    // A CPU sempre começa em PROGRAM_START
+    FlowGraph graph(image);
+    graph.explore(Config::Memory::PROGRAM_START);
+    if (graph.get_leaders().empty()) {
+        std::cerr << "[aot] ERRO: O ponto de entrada " << hex(Config::Memory::PROGRAM_START, 3) << " está fora da ROM" << std::endl;
+        return 1;
+    }
+    std::vector<Block> blocks = build_blocks(image, graph.get_leaders());
+
+    std::ofstream file;
+    if (!output.empty()) {
+        file.open(output);
+        if (!file.is_open()) {
+            std::cerr << "[aot] ERRO: Não foi possível criar " << output << std::endl;
+            return 1;
+        }
+    }
+    write_program(output.empty() ? std::cout : file, name, rom_path, image, blocks);
+
+    int instructions = 0;
+    for (const Block& block : blocks) instructions += block.instructions;
+    std::cerr << "[aot] " << name << ": " << blocks.size() << " blocos, " << instructions << " instruções traduzidas";
+    if (graph.get_unresolved()) std::cerr << ", " << graph.get_unresolved() << " BNNN sem destino (interpretador)";
+    std::cerr << std::endl;
+    return 0;
+}
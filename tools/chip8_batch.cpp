@@ -0,0 +1,281 @@
+// Executor em lote do Chip-8
+// Roda milhares de instâncias headless independentes em um pool com roubo de trabalho
+// e emite, por job, o hash final do framebuffer, os ciclos executados e o tempo de parede
+
+#include "../include/chip8.h"
+#include "../include/config.h"
+#include "../include/input_script.h"
+#include "../include/memory.h"
+#include "../include/null_platform.h"
+#include "../include/thread_pool.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::vector<std::string> roms;
+    std::vector<std::string> scripts;
+    uint32_t seed_base = 1;
+    uint32_t seed_count = 1;
+    uint64_t max_frames = 0;
+    uint64_t max_cycles = 0;
+    unsigned threads = 0;
+    int clock_hz = Config::CPU::DEFAULT_CLOCK_SPEED;
+    int ipf = 0;
+    uint16_t load_addr = Config::Memory::PROGRAM_START;
+    CpuBackend backend = CpuBackend::Interpreter;
+    bool idle_skip = true;
+    bool fusion = true;
+    std::string output;
+};
+
+// Um job: ROM x semente x script
+struct Job {
+    size_t rom;
+    uint32_t seed;
+    int script; // -1 = sem script
+};
+
+struct Result {
+    bool ok = false;
+    uint64_t frames = 0;
+    uint64_t cycles = 0;
+    uint64_t idle_cycles = 0;
+    uint64_t hash = 0;
+    double wall_us = 0;
+};
+
+void print_usage(const char* exe) {
+    std::cout << "Uso: " << exe << " (--rom <arquivo> ... | --rom-list <arquivo>) (--frames <n> | --cycles <n>)"
+              << " [--seeds <n>] [--seed <s>] [--script <arquivo> ...] [--threads <n>]"
+              << " [--cpu <interp|jit|aot>] [--no-idle-skip] [--no-fusion] [--clock <Hz>] [--ipf <n>] [--loadaddr <hex>] [--output <arquivo.csv>]" << std::endl;
+    std::cout << "  --rom <arquivo>       ROM a executar (pode repetir)" << std::endl;
+    std::cout << "  --rom-list <arquivo>  Arquivo com uma ROM por linha" << std::endl;
+    std::cout << "  --frames <n>          Quadros emulados por job" << std::endl;
+    std::cout << "  --cycles <n>          Encerra o job após o quadro em que n instruções forem atingidas" << std::endl;
+    std::cout << "  --seeds <n>           Sementes por ROM: seed, seed + 1, ... (padrão: 1)" << std::endl;
+    std::cout << "  --seed <s>            Primeira semente do gerador de CXKK (padrão: 1)" << std::endl;
+    std::cout << "  --script <arquivo>    Script de entrada \"<quadro> <tecla> <down|up>\" (pode repetir)" << std::endl;
+    std::cout << "  --threads <n>         Threads do pool (padrão: todos os núcleos)" << std::endl;
+    std::cout << "  --cpu <interp|jit|aot> Motor de execução da CPU (padrão: interp; aot exige o programa gerado pelo chip8-aot)" << std::endl;
+    std::cout << "  --no-idle-skip        Não pula laços ociosos (para comparar resultados)" << std::endl;
+    std::cout << "  --no-fusion           Não funde sequências de opcodes (para comparar resultados)" << std::endl;
+    std::cout << "  --output <arquivo>    Grava o CSV no arquivo em vez da saída padrão" << std::endl;
+}
+
+// Lê um inteiro positivo
+bool parse_positive(const char* text, uint64_t& out) {
+    try {
+        long long v = std::stoll(text);
+        if (v <= 0) return false;
+        out = static_cast<uint64_t>(v);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+// Executa um job do início ao fim em uma instância própria
+Result run_job(const Options& options, const std::vector<uint8_t>& rom, const InputScript* script, uint32_t seed) {
+    Result result;
+    auto start = std::chrono::steady_clock::now();
+
+    NullPlatform platform;
+    Chip8 chip8(false);
+    chip8.initialize(platform, options.clock_hz);
+    if (!chip8.load_rom(rom, options.load_addr)) return result;
+    chip8.set_seed(seed);
+    chip8.set_cpu_backend(options.backend);
+    chip8.set_idle_skip(options.idle_skip);
+    chip8.set_fusion(options.fusion);
+    if (options.ipf > 0) chip8.set_instructions_per_frame(options.ipf);
+
+    size_t cursor = 0;
+    while (true) {
+        if (script) {
+            script->apply(result.frames, cursor, [&](uint8_t key, bool pressed) { chip8.set_key(key, pressed); });
+        }
+        result.cycles += chip8.run_frame();
+        ++result.frames;
+        if (options.max_frames && result.frames >= options.max_frames) break;
+        if (options.max_cycles && result.cycles >= options.max_cycles) break;
+    }
+
+    result.idle_cycles = chip8.get_idle_cycles();
+    result.hash = chip8.get_display().hash();
+    result.ok = true;
+    result.wall_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&](const char* name) -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "[batch] ERRO: Falta valor para " << name << std::endl;
+                print_usage(argv[0]);
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+        auto invalid = [&](const char* name) {
+            std::cerr << "[batch] ERRO: Valor inválido para " << name << std::endl;
+            std::exit(1);
+        };
+        uint64_t number = 0;
+
+        if (arg == "--rom") {
+            options.roms.push_back(value("--rom"));
+        } else if (arg == "--rom-list") {
+            std::ifstream list(value("--rom-list"));
+            if (!list.is_open()) invalid("--rom-list");
+            std::string line;
+            while (std::getline(list, line)) {
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (!line.empty() && line[0] != '#') options.roms.push_back(line);
+            }
+        } else if (arg == "--script") {
+            options.scripts.push_back(value("--script"));
+        } else if (arg == "--frames") {
+            if (!parse_positive(value("--frames"), options.max_frames)) invalid("--frames");
+        } else if (arg == "--cycles") {
+            if (!parse_positive(value("--cycles"), options.max_cycles)) invalid("--cycles");
+        } else if (arg == "--seeds") {
+            if (!parse_positive(value("--seeds"), number) || number > UINT32_MAX) invalid("--seeds");
+            options.seed_count = static_cast<uint32_t>(number);
+        } else if (arg == "--seed") {
+            if (!parse_positive(value("--seed"), number) || number > UINT32_MAX) invalid("--seed");
+            options.seed_base = static_cast<uint32_t>(number);
+        } else if (arg == "--threads") {
+            if (!parse_positive(value("--threads"), number) || number > 4096) invalid("--threads");
+            options.threads = static_cast<unsigned>(number);
+        } else if (arg == "--clock") {
+            if (!parse_positive(value("--clock"), number) || number > INT32_MAX) invalid("--clock");
+            options.clock_hz = static_cast<int>(number);
+        } else if (arg == "--ipf") {
+            if (!parse_positive(value("--ipf"), number) || number > INT32_MAX) invalid("--ipf");
+            options.ipf = static_cast<int>(number);
+        } else if (arg == "--loadaddr") {
+            try {
+                unsigned long v = std::stoul(value("--loadaddr"), nullptr, 0);
+                if (v > 0xFFFF) throw std::out_of_range("range");
+                options.load_addr = static_cast<uint16_t>(v);
+            } catch (...) {
+                invalid("--loadaddr");
+            }
+        } else if (arg == "--cpu") {
+            std::string backend = value("--cpu");
+            if (backend == "interp") {
+                options.backend = CpuBackend::Interpreter;
+            } else if (backend == "jit") {
+                options.backend = CpuBackend::Jit;
+            } else if (backend == "aot") {
+                options.backend = CpuBackend::Aot;
+            } else {
+                invalid("--cpu (use interp, jit ou aot)");
+            }
+        } else if (arg == "--no-idle-skip") {
+            options.idle_skip = false;
+        } else if (arg == "--no-fusion") {
+            options.fusion = false;
+        } else if (arg == "--output") {
+            options.output = value("--output");
+        } else if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "[batch] ERRO: Argumento desconhecido: " << arg << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (options.roms.empty() || (options.max_frames == 0 && options.max_cycles == 0)) {
+        std::cerr << "[batch] ERRO: Informe ao menos uma ROM e --frames ou --cycles." << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    // Cada ROM e script é lido uma vez e compartilhado (somente leitura) entre os jobs
+    std::vector<std::vector<uint8_t>> rom_images(options.roms.size());
+    for (size_t r = 0; r < options.roms.size(); ++r) {
+        if (!Memory::read_rom_file(options.roms[r], rom_images[r])) return 1;
+    }
+    std::vector<InputScript> scripts(options.scripts.size());
+    for (size_t s = 0; s < options.scripts.size(); ++s) {
+        if (!scripts[s].load(options.scripts[s])) return 1;
+    }
+
+    // Produto cartesiano ROM x semente x script
+    std::vector<Job> jobs;
+    int script_count = scripts.empty() ? 1 : static_cast<int>(scripts.size());
+    for (size_t r = 0; r < options.roms.size(); ++r) {
+        for (uint32_t k = 0; k < options.seed_count; ++k) {
+            for (int s = 0; s < script_count; ++s) {
+                jobs.push_back(Job{r, options.seed_base + k, scripts.empty() ? -1 : s});
+            }
+        }
+    }
+
+    std::vector<Result> results(jobs.size());
+    auto start = std::chrono::steady_clock::now();
+    unsigned thread_count;
+    {
+        ThreadPool pool(options.threads);
+        thread_count = pool.size();
+        for (size_t j = 0; j < jobs.size(); ++j) {
+            pool.submit([&, j] {
+                const Job& job = jobs[j];
+                const InputScript* script = job.script >= 0 ? &scripts[job.script] : nullptr;
+                results[j] = run_job(options, rom_images[job.rom], script, job.seed);
+            });
+        }
+        pool.wait();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Resultados na ordem dos jobs, independente da ordem de execução
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file.is_open()) {
+            std::cerr << "[batch] ERRO: Não foi possível criar " << options.output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = options.output.empty() ? std::cout : file;
+    out << "job,rom,seed,script,status,frames,cycles,idle_cycles,hash,wall_us\n";
+    uint64_t total_cycles = 0;
+    uint64_t total_idle = 0;
+    size_t failed = 0;
+    char hash[17];
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        const Job& job = jobs[j];
+        const Result& r = results[j];
+        std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(r.hash));
+        out << j << ',' << options.roms[job.rom] << ',' << job.seed << ','
+            << (job.script >= 0 ? options.scripts[job.script] : "") << ',' << (r.ok ? "ok" : "erro") << ','
+            << r.frames << ',' << r.cycles << ',' << r.idle_cycles << ',' << hash << ',' << static_cast<uint64_t>(r.wall_us) << '\n';
+        total_cycles += r.cycles;
+        total_idle += r.idle_cycles;
+        if (!r.ok) ++failed;
+    }
+    out.flush();
+
+    std::cerr << "[batch] " << jobs.size() << " jobs (" << failed << " com erro) em " << seconds << " s com "
+              << thread_count << " threads (" << static_cast<uint64_t>(jobs.size() / seconds) << " jobs/s, "
+              << static_cast<uint64_t>(total_cycles / seconds) << " instr/s agregados, "
+              << total_idle << " em laços ociosos)" << std::endl;
+    return failed ? 1 : 0;
+}
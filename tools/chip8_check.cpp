@@ -0,0 +1,399 @@
+// Verificação diferencial do Chip-8
+// Roda as mesmas ROMs por caminhos de execução que precisam chegar ao mesmo estado emulado e
+// compara os MachineState campo a campo, quadro a quadro:
+//     lockstep  cada lane de um LockstepGroup contra um Chip8 escalar com a mesma semente e as
+//               mesmas teclas (FX0A e laços ociosos divergindo entre as lanes)
+//     fusion    interpretador com fusão de opcodes contra o interpretador sem fusão
+//     aot       programas gerados pelo chip8-aot contra o interpretador, nas ROMs que têm um
+//               programa ligado ao executável (make aot-check gera e liga o de cada ROM)
+// ROMs: as de roms/ (ou --rom) e ROMs de verificação montadas aqui, que exercitam os casos
+// difíceis (--write-roms grava estas em arquivos). Sai com código 1 na primeira divergência de
+// cada caso, dizendo onde ela ocorreu.
+
+#include "../include/aot.h"
+#include "../include/chip8.h"
+#include "../include/config.h"
+#include "../include/lockstep.h"
+#include "../include/machine_state.h"
+#include "../include/memory.h"
+#include "../include/null_platform.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// ROM de verificação: trechos de opcodes e dados em endereços fixos
+struct Rom {
+    std::string name;
+    std::vector<uint8_t> bytes;  // A partir de PROGRAM_START
+    std::vector<bool> written;   // Bytes já montados (trechos sobrepostos são erro de montagem)
+
+    explicit Rom(std::string name) : name(std::move(name)) {}
+
+    // Grava os opcodes a partir de address (big-endian)
+    Rom& code(uint16_t address, const std::vector<uint16_t>& opcodes) {
+        for (uint16_t opcode : opcodes) {
+            put(address++, static_cast<uint8_t>(opcode >> 8));
+            put(address++, static_cast<uint8_t>(opcode & 0xFF));
+        }
+        return *this;
+    }
+
+    // Grava bytes de dados a partir de address
+    Rom& data(uint16_t address, const std::vector<uint8_t>& values) {
+        for (uint8_t value : values) put(address++, value);
+        return *this;
+    }
+
+private:
+    void put(uint16_t address, uint8_t value) {
+        size_t offset = address - Config::Memory::PROGRAM_START;
+        if (address < Config::Memory::PROGRAM_START || address >= Config::Memory::SIZE) {
+            throw std::logic_error(name + ": endereço fora da área de programa");
+        }
+        if (offset >= bytes.size()) {
+            bytes.resize(offset + 1, 0);
+            written.resize(offset + 1, false);
+        }
+        if (written[offset]) throw std::logic_error(name + ": trechos sobrepostos");
+        bytes[offset] = value;
+        written[offset] = true;
+    }
+};
+
+// ROMs de verificação
+std::vector<Rom> check_roms() {
+    std::vector<Rom> list;
+
+    // Cobertura: ALU em várias combinações de registradores (inclusive VF como operando), RND,
+    // timers, BCD, FX55/FX65, fonte, DXYN com volta na borda, CALL/RET, saltos e teclas; a
+    // sub-rotina em 0x500 escreve a instrução em 0x510 ("6C VA") e a executa em seguida
+    Rom alu("check-alu");
+    alu.code(0x200, {0x6A05, 0x6B07, 0x6FFE, 0x60F3, 0x61A9});
+    std::vector<uint16_t> sweep;
+    for (int x = 0; x < 16; x += 3) {
+        for (int y = 0; y < 16; y += 5) {
+            for (int n : {0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0xE}) sweep.push_back(0x8000 | x << 8 | y << 4 | n);
+        }
+    }
+    sweep.insert(sweep.end(), {0x8FA4, 0x8AF5, 0x8FF6, 0x8F07, 0x8FFE, 0x8AF7, 0x7A13, 0x7F01, 0xC03F, 0xC1FF,
+                               0xA700, 0xFA33, 0xF265, 0xA710, 0xFF55, 0xA710, 0xF565, 0xF029, 0xD015, 0xA700,
+                               0xD5A8, 0x2500, 0xF615, 0xF707, 0xF818, 0xF61E, 0x3A00, 0x4B01, 0x5AB0, 0x9AB0,
+                               0xE59E, 0xE5A1, 0x6F00, 0x120A});
+    alu.code(0x20A, sweep);
+    alu.code(0x500, {0x6E6C, 0xA510, 0x80E0, 0x81A0, 0xF155, 0x1510});
+    alu.code(0x510, {0x0000, 0x00EE});
+    list.push_back(alu);
+
+    // Teclas: espera pelo delay timer (valor aleatório, então cada semente sai do laço ocioso
+    // num quadro diferente), FX0A, desenho do dígito, BCD e espera ociosa até a mesma tecla
+    // ser pressionada de novo (SKP)
+    Rom keys("check-keys");
+    keys.code(0x200, {0xC01F, 0xF015,           // DT = RND & 0x1F
+                      0xF107, 0x3100, 0x1204,   // 204: espera DT = 0
+                      0xF20A,                   // 20A: V2 = tecla
+                      0xF229, 0xD345, 0x7305, 0xE29E, 0x7408,
+                      0xA720, 0xF233, 0xF265, 0xF318,
+                      0xE29E, 0x121E,           // 21E: espera pressionar a tecla de novo
+                      0x1200});
+    list.push_back(keys);
+
+    // Fusões: todas as sequências de CHIP8_FUSIONS, com escritas do programa de 2 a 5 bytes
+    // depois da cabeça de uma fusão já decodificada:
+    //     216  6405 F415  LD_DT_BYTE; 0x300 troca o byte 0x219 entre 15 e 18 (FX15/FX18)
+    //     21E  COUNTED_LOOP; 0x300 reescreve o KK do SE (0x221) e o alvo do JP (0x223, mesmo
+    //          valor), e o laço atravessa as bordas do orçamento do quadro
+    //     22C  A234 F355  restaura 0x234-0x237 ("F265 6D00"), 2 a 5 bytes depois de 0x232
+    //     232  FA33 F265  BCD_LOAD em que o FX33 sobrescreve o próprio FX65 (I = 0x234): o que
+    //          executa em seguida é "0h0t" e "0u00" (opcodes desconhecidos, sem efeito além
+    //          do aviso do trace)
+    Rom fusion("check-fusion");
+    fusion.code(0x200, {0x6A00, 0x6B00, 0x6C00,
+                        0xA6F0, 0xDBC5, 0x7B03, 0x7C02,         // 206: LD_I_DRW
+                        0xA710, 0xF365, 0xA720, 0xF355,         // 20E: LD_I_LOAD, LD_I_STORE
+                        0x6405, 0xF415,                         // 216: LD_DT_BYTE
+                        0x2300,                                 // 21A: reescreve 0x219, 0x221, 0x223
+                        0x6500, 0x7501, 0x3517, 0x121E,         // 21E: COUNTED_LOOP
+                        0x60F2, 0x6165, 0x626D, 0x6300, 0xA234, 0xF355,
+                        0xA234, 0xFA33, 0xF265, 0x6D00,         // 230: BCD_LOAD em 232
+                        0xF407, 0x3400, 0x1238,                 // 238: espera DT = 0
+                        0x7A07, 0x1206});
+    fusion.code(0x300, {0x80A0, 0x6101, 0x8012, 0x8200, 0x8024, 0x8024, 0x7015, 0xA219, 0xF055,  // [219] = 15 + 3 * (VA & 1)
+                        0x80A0, 0x611F, 0x8012, 0x7001, 0xA221, 0xF055,                          // [221] = (VA & 1F) + 1
+                        0x601E, 0xA223, 0xF055,                                                  // [223] = 1E
+                        0x00EE});
+    fusion.data(0x6F0, {0xF0, 0x90, 0xF0, 0x90, 0xF0});
+    list.push_back(fusion);
+
+    // BNNN por uma tabela de JPs que o próprio programa reescreve: a cada passagem a entrada
+    // usada passa a apontar para o alvo seguinte ou para o meio dele (0x292 e afins, que não
+    // começam bloco no programa gerado a partir da tabela original)
+    Rom jump_table("check-bnnn");
+    jump_table.code(0x200, {0x6E00,
+                            0x7E01, 0x80E0, 0x6606, 0x8062,            // 202: V0 = VE & 6
+                            0xB280});
+    jump_table.code(0x220, {0x8500, 0x7502, 0x8562,                    // V5 = (V0 + 2) & 6
+                            0x8554, 0x8554, 0x8554, 0x7590,            // V5 = 90 + 8 * V5
+                            0x86E0, 0x6701, 0x8672, 0x8664, 0x8564,    // V5 += 2 * (VE & 1)
+                            0xA280, 0xF01E, 0x6012, 0x8150, 0xF155,    // [280 + V0] = 12 V5
+                            0x1202});
+    jump_table.code(0x280, {0x1290, 0x12A0, 0x12B0, 0x12C0});
+    jump_table.code(0x290, {0x7201, 0x1220});
+    jump_table.code(0x2A0, {0x7302, 0x1220});
+    jump_table.code(0x2B0, {0x7403, 0x1220});
+    jump_table.code(0x2C0, {0x7904, 0x1220});
+    list.push_back(jump_table);
+
+    return list;
+}
+
+// Teclas da instância i no quadro f: cada instância troca de tecla em ritmo próprio, às vezes
+// solta todas e de tempos em tempos dá um toque (soltar e pressionar dentro do quadro, com a
+// tecla segurada ou não), então as esperas do FX0A começam e terminam em quadros diferentes
+void keys_for(int i, uint64_t frame, uint16_t& mask, uint16_t& presses) {
+    uint64_t phase = frame / (5 + i);
+    uint16_t key = static_cast<uint16_t>(1u << ((phase + i) % 16));
+    mask = phase % 3 == 2 ? 0 : key;
+    presses = frame % (3 + i % 4) == 0 ? key : 0;
+}
+
+// Primeira parte do estado em que a e b diferem ("" se iguais); o preenchimento não conta
+std::string state_diff(const MachineState& a, const MachineState& b) {
+    const CpuState& x = a.cpu;
+    const CpuState& y = b.cpu;
+    if (x.V != y.V) return "V";
+    if (x.I != y.I) return "I";
+    if (x.PC != y.PC) return "PC";
+    if (x.SP != y.SP || x.stack != y.stack) return "pilha";
+    if (x.delay_timer != y.delay_timer || x.sound_timer != y.sound_timer) return "timers";
+    if (x.rng_state != y.rng_state) return "gerador";
+    if (x.key_wait_reg != y.key_wait_reg || x.key_wait_held != y.key_wait_held || x.key_wait_pressed != y.key_wait_pressed) {
+        return "espera do FX0A";
+    }
+    if (a.input.keys != b.input.keys || a.input.presses != b.input.presses) return "teclas";
+    if (a.display.rows != b.display.rows) return "framebuffer";
+    if (a.ram == b.ram) return "";
+    for (size_t i = 0; i < a.ram.size(); ++i) {
+        if (a.ram[i] != b.ram[i]) {
+            char where[32];
+            std::snprintf(where, sizeof(where), "RAM em 0x%03zX", i);
+            return where;
+        }
+    }
+    return "";
+}
+
+// Quadros por caso: ao menos min_frames e cerca de 40000 instruções
+uint64_t frames_for(int ipf, uint64_t min_frames) {
+    return std::max<uint64_t>(min_frames, 40000 / ipf);
+}
+
+// Cada lane (semente 1 + l, teclas próprias) contra um Chip8 escalar, quadro a quadro
+bool check_lockstep(const Rom& rom, int ipf, bool idle_skip, std::string& error) {
+    NullPlatform platform;
+    LockstepGroup group(LockstepGroup::LANES, ipf);
+    group.set_idle_skip(idle_skip);
+    std::vector<std::unique_ptr<Chip8>> scalar;
+    for (int l = 0; l < group.size(); ++l) {
+        scalar.emplace_back(new Chip8(false));
+        Chip8& chip8 = *scalar.back();
+        chip8.initialize(platform);
+        chip8.load_rom(rom.bytes);
+        chip8.set_seed(1 + l);
+        chip8.set_idle_skip(idle_skip);
+        chip8.set_instructions_per_frame(ipf);
+        group.load_lane(l, chip8.get_state());
+    }
+
+    MachineState lane;
+    uint64_t frames = frames_for(ipf, 600);
+    for (uint64_t f = 0; f < frames; ++f) {
+        for (int l = 0; l < group.size(); ++l) {
+            uint16_t mask, presses;
+            keys_for(l, f, mask, presses);
+            group.apply_keys(l, mask, presses);
+            scalar[l]->apply_keys(mask, presses);
+            scalar[l]->run_frame();
+        }
+        group.run_frame();
+        for (int l = 0; l < group.size(); ++l) {
+            group.save_lane(l, lane);
+            std::string diff = state_diff(lane, scalar[l]->get_state());
+            if (diff.empty() && group.get_idle_cycles(l) != scalar[l]->get_idle_cycles()) diff = "instruções ociosas";
+            if (!diff.empty()) {
+                error = "lane " + std::to_string(l) + ", quadro " + std::to_string(f) + ": " + diff;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Motor comparado com a referência (interpretador sem fusão)
+struct Engine {
+    const char* name;
+    CpuBackend backend;
+    bool fusion;
+};
+
+// Há programa do chip8-aot ligado para a ROM
+bool has_aot_program(const Rom& rom) {
+    std::array<uint8_t, Memory::MEMORY_SIZE> ram{};
+    if (rom.bytes.size() > ram.size() - Config::Memory::PROGRAM_START) return false;
+    std::copy(rom.bytes.begin(), rom.bytes.end(), ram.begin() + Config::Memory::PROGRAM_START);
+    return Aot::find_program(ram) != nullptr;
+}
+
+// Grava as ROMs de verificação em dir/<nome>.ch8
+bool write_roms(const std::vector<Rom>& roms, const std::string& dir) {
+    for (const Rom& rom : roms) {
+        std::string path = dir + "/" + rom.name + ".ch8";
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(rom.bytes.data()), static_cast<std::streamsize>(rom.bytes.size()));
+        if (!file) {
+            std::cerr << "[check] ERRO: Não foi possível gravar " << path << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Um Chip8 com a ROM e a configuração do caso
+std::unique_ptr<Chip8> boot(NullPlatform& platform, const Rom& rom, int ipf, bool idle_skip, CpuBackend backend, bool fusion) {
+    std::unique_ptr<Chip8> chip8(new Chip8(false));
+    chip8->initialize(platform);
+    chip8->load_rom(rom.bytes);
+    chip8->set_seed(1);
+    chip8->set_idle_skip(idle_skip);
+    chip8->set_fusion(fusion);
+    chip8->set_cpu_backend(backend);
+    chip8->set_instructions_per_frame(ipf);
+    return chip8;
+}
+
+// O motor contra o interpretador sem fusão, com as mesmas teclas, quadro a quadro
+bool check_engine(const Rom& rom, const Engine& engine, int ipf, bool idle_skip, std::string& error) {
+    NullPlatform platform;
+    std::unique_ptr<Chip8> reference = boot(platform, rom, ipf, idle_skip, CpuBackend::Interpreter, false);
+    std::unique_ptr<Chip8> tested = boot(platform, rom, ipf, idle_skip, engine.backend, engine.fusion);
+    uint64_t frames = frames_for(ipf, 600);
+    for (uint64_t f = 0; f < frames; ++f) {
+        uint16_t mask, presses;
+        keys_for(0, f, mask, presses);
+        reference->apply_keys(mask, presses);
+        tested->apply_keys(mask, presses);
+        int expected = reference->run_frame();
+        int executed = tested->run_frame();
+        std::string diff = state_diff(tested->get_state(), reference->get_state());
+        if (diff.empty() && executed != expected) diff = "instruções no quadro";
+        if (diff.empty() && tested->get_idle_cycles() != reference->get_idle_cycles()) diff = "instruções ociosas";
+        if (!diff.empty()) {
+            error = "quadro " + std::to_string(f) + ": " + diff;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Instruções por quadro dos casos: 1 e valores pequenos cortam sequências e laços no meio
+const int IPFS[] = {1, 3, 7, 8, 13, 64};
+
+void print_usage(const char* exe) {
+    std::cout << "Uso: " << exe << " [--rom <arquivo> ...] [--only <caso>] [--write-roms <dir>]" << std::endl;
+    std::cout << "  --rom <arquivo>     ROM além das de verificação (padrão: roms/PONG, roms/MAZE e os logos)" << std::endl;
+    std::cout << "  --only <caso>       Roda só um caso: lockstep, fusion ou aot (com aot, ROM sem programa" << std::endl;
+    std::cout << "                      gerado ligado é divergência)" << std::endl;
+    std::cout << "  --write-roms <dir>  Grava as ROMs de verificação em <dir>/<nome>.ch8 e sai" << std::endl;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> paths;
+    std::string only;
+    std::string roms_dir;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "--rom" || arg == "--only" || arg == "--write-roms") && i + 1 >= argc) {
+            std::cerr << "[check] ERRO: Falta valor para " << arg << std::endl;
+            return 1;
+        }
+        if (arg == "--rom") {
+            paths.push_back(argv[++i]);
+        } else if (arg == "--only") {
+            only = argv[++i];
+        } else if (arg == "--write-roms") {
+            roms_dir = argv[++i];
+        } else if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "[check] ERRO: Argumento desconhecido: " << arg << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (paths.empty()) paths = {"roms/PONG", "roms/MAZE", "roms/1-chip8-logo.ch8", "roms/2-ibm-logo.ch8"};
+
+    std::vector<Rom> roms = check_roms();
+    if (!roms_dir.empty()) return write_roms(roms, roms_dir) ? 0 : 1;
+    for (const std::string& path : paths) {
+        Rom rom(path.substr(path.find_last_of("/\\") + 1));
+        if (!Memory::read_rom_file(path, rom.bytes)) {
+            std::cerr << "[check] AVISO: ROM ignorada: " << path << std::endl;
+            continue;
+        }
+        roms.push_back(rom);
+    }
+
+    int failures = 0;
+    int cases = 0;
+    auto report = [&](const char* check, const Rom& rom, const std::string& config, bool ok, const std::string& error) {
+        ++cases;
+        if (ok) return;
+        ++failures;
+        std::cerr << "[check] ERRO: " << check << " " << rom.name << " (" << config << "): " << error << std::endl;
+    };
+
+    if (only.empty() || only == "lockstep") {
+        for (const Rom& rom : roms) {
+            for (int ipf : IPFS) {
+                for (bool idle_skip : {true, false}) {
+                    std::string error;
+                    bool ok = check_lockstep(rom, ipf, idle_skip, error);
+                    report("lockstep", rom, "ipf " + std::to_string(ipf) + (idle_skip ? "" : ", sem salto ocioso"), ok, error);
+                }
+            }
+        }
+    }
+
+    const Engine engines[] = {{"fusion", CpuBackend::Interpreter, true}, {"aot", CpuBackend::Aot, false}};
+    for (const Engine& engine : engines) {
+        if (!only.empty() && only != engine.name) continue;
+        for (const Rom& rom : roms) {
+            if (engine.backend == CpuBackend::Aot && !has_aot_program(rom)) {
+                if (only == engine.name) report(engine.name, rom, "carga", false, "nenhum programa gerado ligado para a ROM");
+                continue;
+            }
+            for (int ipf : IPFS) {
+                for (bool idle_skip : {true, false}) {
+                    std::string error;
+                    bool ok = check_engine(rom, engine, ipf, idle_skip, error);
+                    report(engine.name, rom, "ipf " + std::to_string(ipf) + (idle_skip ? "" : ", sem salto ocioso"), ok, error);
+                }
+            }
+        }
+    }
+
+    std::printf("[check] %d casos, %d divergências\n", cases, failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,135 @@
+// Decodificador de traces do Chip-8
+// Converte o arquivo binário gravado com --trace em texto, uma linha por evento,
+// ou resume as contagens por tipo de evento e por operação
+
+#include "../include/opcodes.h"
+#include "../include/trace.h"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace {
+
+void print_usage(const char* exe) {
+    std::cout << "Uso: " << exe << " <arquivo de trace> [--source <n>] [--kind <tipo>] [--stats]" << std::endl;
+    std::cout << "  --source <n>    Só eventos da origem n (uma CPU por origem)" << std::endl;
+    std::cout << "  --kind <tipo>   Só eventos do tipo (exec, opcode-desconhecido, stack-overflow, ...)" << std::endl;
+    std::cout << "  --stats         Mostra contagens por tipo e por operação em vez dos eventos" << std::endl;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string path;
+    int source_filter = -1;
+    int kind_filter = -1;
+    bool stats = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--source" && i + 1 < argc) {
+            try {
+                source_filter = std::stoi(argv[++i]);
+            } catch (...) {
+                std::cerr << "[trace] ERRO: Valor inválido para --source" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--kind" && i + 1 < argc) {
+            std::string name = argv[++i];
+            for (size_t k = 0; k < TRACE_KIND_COUNT; ++k) {
+                if (name == TRACE_KIND_NAMES[k]) kind_filter = static_cast<int>(k);
+            }
+            if (kind_filter < 0) {
+                std::cerr << "[trace] ERRO: Tipo de evento desconhecido: " << name << std::endl;
+                return 1;
+            }
+        } else if (arg == "--stats") {
+            stats = true;
+        } else if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (path.empty() && arg[0] != '-') {
+            path = arg;
+        } else {
+            std::cerr << "[trace] ERRO: Argumento desconhecido: " << arg << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (path.empty()) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[trace] ERRO: Não foi possível abrir o trace: " << path << std::endl;
+        return 1;
+    }
+    uint8_t header[8];
+    if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+        header[0] != 'C' || header[1] != 'H' || header[2] != '8' || header[3] != 'T') {
+        std::cerr << "[trace] ERRO: Arquivo não é um trace Chip-8: " << path << std::endl;
+        return 1;
+    }
+    uint16_t version = static_cast<uint16_t>(header[4] | (header[5] << 8));
+    if (version != Tracer::VERSION) {
+        std::cerr << "[trace] ERRO: Versão de trace não suportada: " << version
+                  << " (esperada " << Tracer::VERSION << ")" << std::endl;
+        return 1;
+    }
+
+    std::array<uint64_t, TRACE_KIND_COUNT> kind_counts{};
+    std::array<uint64_t, OP_COUNT> op_counts{};
+    uint64_t total = 0;
+    uint8_t bytes[8];
+    while (file.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) {
+        uint16_t pc = static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+        uint16_t opcode = static_cast<uint16_t>(bytes[2] | (bytes[3] << 8));
+        uint8_t kind = bytes[4];
+        uint8_t arg = bytes[5];
+        uint16_t source = static_cast<uint16_t>(bytes[6] | (bytes[7] << 8));
+        if (kind >= TRACE_KIND_COUNT) {
+            std::cerr << "[trace] ERRO: Evento corrompido após " << total << " eventos" << std::endl;
+            return 1;
+        }
+        if (source_filter >= 0 && source != source_filter) continue;
+        if (kind_filter >= 0 && kind != kind_filter) continue;
+        ++total;
+
+        Op op = OPCODE_TABLE[opcode];
+        if (stats) {
+            ++kind_counts[kind];
+            if (static_cast<TraceKind>(kind) == TraceKind::Exec) ++op_counts[static_cast<size_t>(op)];
+            continue;
+        }
+        const char* mnemonic = OP_NAMES[static_cast<size_t>(op)];
+        if (static_cast<TraceKind>(kind) == TraceKind::Exec) {
+            std::printf("%u 0x%03X %04X %s\n", source, pc, opcode, mnemonic);
+            continue;
+        }
+        std::printf("%u 0x%03X %04X %-14s", source, pc, opcode, mnemonic);
+        switch (static_cast<TraceKind>(kind)) {
+            case TraceKind::InvalidKey: std::printf("  ! %s %u", TRACE_KIND_NAMES[kind], arg); break;
+            case TraceKind::FontWrite: std::printf("  ! %s 0x%03X", TRACE_KIND_NAMES[kind], arg); break;
+            default: std::printf("  ! %s", TRACE_KIND_NAMES[kind]); break;
+        }
+        std::printf("\n");
+    }
+
+    if (stats) {
+        std::printf("%llu eventos\n", static_cast<unsigned long long>(total));
+        for (size_t k = 0; k < TRACE_KIND_COUNT; ++k) {
+            if (kind_counts[k]) std::printf("  %-20s %llu\n", TRACE_KIND_NAMES[k], static_cast<unsigned long long>(kind_counts[k]));
+        }
+        if (kind_counts[static_cast<size_t>(TraceKind::Exec)]) {
+            std::printf("Instruções por operação\n");
+            for (size_t o = 0; o < OP_COUNT; ++o) {
+                if (op_counts[o]) std::printf("  %-14s %llu\n", OP_NAMES[o], static_cast<unsigned long long>(op_counts[o]));
+            }
+        }
+    }
+    return 0;
+}